@@ -2,6 +2,8 @@
 
 #include "GUIExt.h"
 
+#include "Loading/UIAsyncLoadRegistry.h"
+
 IMPLEMENT_MODULE(FGUIExtModule, GUIExt)
 
 
@@ -11,4 +13,5 @@ void FGUIExtModule::StartupModule()
 
 void FGUIExtModule::ShutdownModule()
 {
+	FUIAsyncLoadRegistry::Get().Shutdown();
 }
@@ -3,10 +3,11 @@
 #include "Actions/AsyncAction_CreateWidgetAsync.h"
 
 #include "UIFunctionLibrary.h"
+#include "UIManagerSubsystem.h"
+#include "Loading/UIAsyncLoadRegistry.h"
 
 #include "Blueprint/UserWidget.h"
 #include "Blueprint/WidgetBlueprintLibrary.h"
-#include "Engine/AssetManager.h"
 #include "Engine/Engine.h"
 #include "Engine/GameInstance.h"
 #include "Engine/StreamableManager.h"
@@ -25,22 +26,36 @@ void UAsyncAction_CreateWidgetAsync::Activate()
 {
 	static const auto NAME_InputFilterReason{ FName(TEXT("CreatingWidgetAsync")) };
 
-	SuspendInputToken = bSuspendInputUntilComplete ? UUIFunctionLibrary::SuspendInputForPlayer(OwningPlayer.Get(), NAME_InputFilterReason) : NAME_None;
+	if (bSuspendInputUntilComplete)
+	{
+		InputSuspension = UUIFunctionLibrary::SuspendInputScopedForPlayer(OwningPlayer.Get(), NAME_InputFilterReason);
+	}
 
-	StreamingHandle = UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(
-		UserWidgetSoftClass.ToSoftObjectPath(),
-		FStreamableDelegate::CreateUObject(this, &ThisClass::OnWidgetLoaded),
-		FStreamableManager::AsyncLoadHighPriority
-	);
+	// No widget is created when the UI runs headless, this behaves like a load that failed
+
+	const auto* UIManager{ UGameInstance::GetSubsystem<UUIManagerSubsystem>(GameInstance.Get()) };
 
-	// Setup a cancel delegate so that we can resume input if this handler is canceled.
+	if (UIManager && UIManager->IsHeadless())
+	{
+		InputSuspension.Reset();
 
-	StreamingHandle->BindCancelDelegate(FStreamableDelegate::CreateWeakLambda(this,
+		SetReadyToDestroy();
+		return;
+	}
+
+	// Setup a cancel delegate so that we can resume input if this request is canceled.
+
+	LoadRequest = FUIAsyncLoadRegistry::Get().RequestAsyncLoad(
+		UserWidgetSoftClass.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnWidgetLoaded),
+		FStreamableDelegate::CreateWeakLambda(this,
 			[this]()
 			{
-				UUIFunctionLibrary::ResumeInputForPlayer(OwningPlayer.Get(), SuspendInputToken);
+				InputSuspension.Reset();
 			}
-		)
+		),
+		FStreamableManager::AsyncLoadHighPriority,
+		NAME_InputFilterReason
 	);
 }
 
@@ -48,10 +63,10 @@ void UAsyncAction_CreateWidgetAsync::Cancel()
 {
 	Super::Cancel();
 
-	if (StreamingHandle.IsValid())
+	if (LoadRequest.IsValid())
 	{
-		StreamingHandle->CancelHandle();
-		StreamingHandle.Reset();
+		LoadRequest->Cancel();
+		LoadRequest.Reset();
 	}
 }
 
@@ -80,10 +95,7 @@ UAsyncAction_CreateWidgetAsync* UAsyncAction_CreateWidgetAsync::CreateWidgetAsyn
 
 void UAsyncAction_CreateWidgetAsync::OnWidgetLoaded()
 {
-	if (bSuspendInputUntilComplete)
-	{
-		UUIFunctionLibrary::ResumeInputForPlayer(OwningPlayer.Get(), SuspendInputToken);
-	}
+	InputSuspension.Reset();
 
 	// If the load as successful, create it, otherwise don't complete this.
 
@@ -91,10 +103,15 @@ void UAsyncAction_CreateWidgetAsync::OnWidgetLoaded()
 	{
 		auto* UserWidget{ UWidgetBlueprintLibrary::Create(World.Get(), UserWidgetClass, OwningPlayer.Get()) };
 
+		if (auto* UIManager{ UGameInstance::GetSubsystem<UUIManagerSubsystem>(GameInstance.Get()) })
+		{
+			UIManager->NotifyWidgetClassUsed(OwningPlayer.IsValid() ? OwningPlayer->GetLocalPlayer() : nullptr, FGameplayTag(), UserWidgetClass);
+		}
+
 		OnComplete.Broadcast(UserWidget);
 	}
 
-	StreamingHandle.Reset();
+	LoadRequest.Reset();
 
 	SetReadyToDestroy();
 }
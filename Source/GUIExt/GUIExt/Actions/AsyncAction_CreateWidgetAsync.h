@@ -4,13 +4,15 @@
 
 #include "Engine/CancellableAsyncAction.h"
 
+#include "Input/UIInputSuspensionSubsystem.h"
+
 #include "AsyncAction_CreateWidgetAsync.generated.h"
 
 class APlayerController;
 class UGameInstance;
 class UUserWidget;
 class UWorld;
-struct FStreamableHandle;
+class FUIAsyncLoadRequest;
 
 
 /**
@@ -34,7 +36,7 @@ public:
 	FCreateWidgetAsyncDelegate OnComplete;
 
 private:
-	FName SuspendInputToken;
+	FUIInputSuspensionHandle InputSuspension;
 	TWeakObjectPtr<APlayerController> OwningPlayer;
 	TWeakObjectPtr<UWorld> World;
 	TWeakObjectPtr<UGameInstance> GameInstance;
@@ -42,7 +44,7 @@ private:
 	bool bSuspendInputUntilComplete{ true };
 
 	TSoftClassPtr<UUserWidget> UserWidgetSoftClass;
-	TSharedPtr<FStreamableHandle> StreamingHandle;
+	TSharedPtr<FUIAsyncLoadRequest> LoadRequest;
 
 public:
 	virtual void Activate() override;
@@ -0,0 +1,129 @@
+// Copyright (C) 2024 owoDra
+
+#include "Actions/AsyncAction_PushContentSequenceToLayersForPlayer.h"
+
+#include "UILayout.h"
+#include "UIPolicy.h"
+#include "UIFunctionLibrary.h"
+
+#include "Engine/Engine.h"
+#include "UObject/Stack.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AsyncAction_PushContentSequenceToLayersForPlayer)
+
+
+UAsyncAction_PushContentSequenceToLayersForPlayer::UAsyncAction_PushContentSequenceToLayersForPlayer(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+
+void UAsyncAction_PushContentSequenceToLayersForPlayer::Activate()
+{
+	if (auto* RootLayout{ UUILayout::GetUILayout(OwningPlayerPtr.Get()) })
+	{
+		auto WeakThis{ TWeakObjectPtr<UAsyncAction_PushContentSequenceToLayersForPlayer>(this) };
+		const auto NumEntries{ Entries.Num() };
+
+		Sequence = RootLayout->PushWidgetSequenceToLayers(Entries, bSuspendInputUntilComplete,
+			[this, WeakThis, NumEntries](EAsyncWidgetLayerState State, int32 EntryIndex, UCommonActivatableWidget* Widget)
+			{
+				if (WeakThis.IsValid())
+				{
+					switch (State)
+					{
+					case EAsyncWidgetLayerState::Initialize:
+						BeforePush.Broadcast(Widget, EntryIndex);
+						break;
+
+					case EAsyncWidgetLayerState::AfterPush:
+						AfterPush.Broadcast(Widget, EntryIndex);
+
+						if (EntryIndex == (NumEntries - 1))
+						{
+							OnComplete.Broadcast();
+							SetReadyToDestroy();
+						}
+						break;
+
+					case EAsyncWidgetLayerState::Canceled:
+						OnCanceled.Broadcast();
+						SetReadyToDestroy();
+						break;
+					}
+				}
+			}
+		);
+
+		if (!Sequence->IsActive() && (Sequence->GetNumPushed() == 0))
+		{
+			SetReadyToDestroy();
+		}
+	}
+	else
+	{
+		// Headless players record the whole sequence at once, there is no widget to broadcast
+
+		auto* PlayerController{ OwningPlayerPtr.Get() };
+		auto* Policy{ PlayerController ? UUIPolicy::GetUIPolicy(PlayerController) : nullptr };
+
+		if (auto* HeadlessLayout{ Policy ? Policy->GetHeadlessLayout(PlayerController->GetLocalPlayer()) : nullptr })
+		{
+			// The input is still suspended and resumed like a sequence that completes right away
+
+			static const auto NAME_PushingWidgetSequence{ FName(TEXT("PushingWidgetSequence")) };
+
+			FUIInputSuspensionHandle InputSuspension;
+
+			if (bSuspendInputUntilComplete)
+			{
+				InputSuspension = UUIFunctionLibrary::SuspendInputScopedForPlayer(PlayerController, NAME_PushingWidgetSequence);
+			}
+
+			for (const auto& Entry : Entries)
+			{
+				HeadlessLayout->Push(Entry.LayerTag, Entry.WidgetClass.ToSoftObjectPath());
+			}
+
+			InputSuspension.Reset();
+
+			OnComplete.Broadcast();
+		}
+
+		SetReadyToDestroy();
+	}
+}
+
+void UAsyncAction_PushContentSequenceToLayersForPlayer::Cancel()
+{
+	Super::Cancel();
+
+	if (Sequence.IsValid())
+	{
+		Sequence->Cancel();
+		Sequence.Reset();
+	}
+}
+
+
+UAsyncAction_PushContentSequenceToLayersForPlayer* UAsyncAction_PushContentSequenceToLayersForPlayer::PushContentSequenceToLayersForPlayer(APlayerController* InOwningPlayer, const TArray<FUILayerPushSequenceEntry>& InEntries, bool bSuspendInputUntilComplete)
+{
+	if (InEntries.IsEmpty())
+	{
+		FFrame::KismetExecutionMessage(TEXT("PushContentSequenceToLayersForPlayer was passed no entries"), ELogVerbosity::Error);
+		return nullptr;
+	}
+
+	if (auto* World{ GEngine->GetWorldFromContextObject(InOwningPlayer, EGetWorldErrorMode::LogAndReturnNull) })
+	{
+		auto* Action{ NewObject<UAsyncAction_PushContentSequenceToLayersForPlayer>() };
+		Action->Entries = InEntries;
+		Action->OwningPlayerPtr = InOwningPlayer;
+		Action->bSuspendInputUntilComplete = bSuspendInputUntilComplete;
+		Action->RegisterWithGameInstance(World);
+
+		return Action;
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,65 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Engine/CancellableAsyncAction.h"
+
+#include "Loading/UILayerPushSequence.h"
+
+#include "AsyncAction_PushContentSequenceToLayersForPlayer.generated.h"
+
+class APlayerController;
+class UCommonActivatableWidget;
+
+
+/**
+ * Delegate notifying the push of an entry of the sequence
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FPushContentSequenceEntryDelegate, UCommonActivatableWidget*, UserWidget, int32, EntryIndex);
+
+/**
+ * Delegate notifying the end of the sequence
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FPushContentSequenceDelegate);
+
+
+/**
+ * Loads several widgets in parallel and pushes them into their layers in the declared order
+ */
+UCLASS(BlueprintType)
+class UAsyncAction_PushContentSequenceToLayersForPlayer : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+public:
+	UAsyncAction_PushContentSequenceToLayersForPlayer(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+public:
+	UPROPERTY(BlueprintAssignable)
+	FPushContentSequenceEntryDelegate BeforePush;
+
+	UPROPERTY(BlueprintAssignable)
+	FPushContentSequenceEntryDelegate AfterPush;
+
+	UPROPERTY(BlueprintAssignable)
+	FPushContentSequenceDelegate OnComplete;
+
+	UPROPERTY(BlueprintAssignable)
+	FPushContentSequenceDelegate OnCanceled;
+
+private:
+	TArray<FUILayerPushSequenceEntry> Entries;
+
+	bool bSuspendInputUntilComplete{ true };
+
+	TWeakObjectPtr<APlayerController> OwningPlayerPtr;
+
+	TSharedPtr<FUILayerPushSequence> Sequence;
+
+public:
+	virtual void Activate() override;
+	virtual void Cancel() override;
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, meta = (BlueprintInternalUseOnly = "true"))
+	static UAsyncAction_PushContentSequenceToLayersForPlayer* PushContentSequenceToLayersForPlayer(APlayerController* OwningPlayer, const TArray<FUILayerPushSequenceEntry>& Entries, bool bSuspendInputUntilComplete = true);
+
+};
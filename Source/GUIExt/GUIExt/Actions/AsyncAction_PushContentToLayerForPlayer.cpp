@@ -3,6 +3,8 @@
 #include "Actions/AsyncAction_PushContentToLayerForPlayer.h"
 
 #include "UILayout.h"
+#include "UIPolicy.h"
+#include "UIFunctionLibrary.h"
 
 #include "Engine/Engine.h"
 #include "UObject/Stack.h"
@@ -23,7 +25,7 @@ void UAsyncAction_PushContentToLayerForPlayer::Activate()
 	{
 		auto WeakThis{ TWeakObjectPtr<UAsyncAction_PushContentToLayerForPlayer>(this) };
 
-		StreamingHandle = RootLayout->PushWidgetToLayerStackAsync<UCommonActivatableWidget>(LayerName, bSuspendInputUntilComplete, WidgetClass, 
+		LoadRequest = RootLayout->PushWidgetToLayerStackAsync<UCommonActivatableWidget>(LayerName, bSuspendInputUntilComplete, WidgetClass, 
 			[this, WeakThis](EAsyncWidgetLayerState State, UCommonActivatableWidget* Widget) 
 			{
 				if (WeakThis.IsValid())
@@ -51,6 +53,27 @@ void UAsyncAction_PushContentToLayerForPlayer::Activate()
 	}
 	else
 	{
+		// Headless players only record the push, there is no widget to broadcast
+
+		auto* PlayerController{ OwningPlayerPtr.Get() };
+		auto* Policy{ PlayerController ? UUIPolicy::GetUIPolicy(PlayerController) : nullptr };
+
+		if (auto* HeadlessLayout{ Policy ? Policy->GetHeadlessLayout(PlayerController->GetLocalPlayer()) : nullptr })
+		{
+			// The input is still suspended and resumed like a push that completes right away
+
+			static const auto NAME_PushingWidgetToLayer{ FName(TEXT("PushingWidgetToLayer")) };
+
+			FUIInputSuspensionHandle InputSuspension;
+
+			if (bSuspendInputUntilComplete)
+			{
+				InputSuspension = UUIFunctionLibrary::SuspendInputScopedForPlayer(PlayerController, NAME_PushingWidgetToLayer);
+			}
+
+			HeadlessLayout->Push(LayerName, WidgetClass.ToSoftObjectPath());
+		}
+
 		SetReadyToDestroy();
 	}
 }
@@ -59,10 +82,10 @@ void UAsyncAction_PushContentToLayerForPlayer::Cancel()
 {
 	Super::Cancel();
 
-	if (StreamingHandle.IsValid())
+	if (LoadRequest.IsValid())
 	{
-		StreamingHandle->CancelHandle();
-		StreamingHandle.Reset();
+		LoadRequest->Cancel();
+		LoadRequest.Reset();
 	}
 }
 
@@ -10,7 +10,7 @@
 
 class APlayerController;
 class UCommonActivatableWidget;
-struct FStreamableHandle;
+class FUIAsyncLoadRequest;
 
 
 /**
@@ -44,7 +44,7 @@ private:
 	TWeakObjectPtr<APlayerController> OwningPlayerPtr;
 	TSoftClassPtr<UCommonActivatableWidget> WidgetClass;
 
-	TSharedPtr<FStreamableHandle> StreamingHandle;
+	TSharedPtr<FUIAsyncLoadRequest> LoadRequest;
 
 public:
 	virtual void Activate() override;
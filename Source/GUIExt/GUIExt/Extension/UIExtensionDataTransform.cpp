@@ -0,0 +1,22 @@
+// Copyright (C) 2024 owoDra
+
+#include "UIExtensionDataTransform.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UIExtensionDataTransform)
+
+
+TSharedPtr<FUIExtensionDataView> UUIExtensionDataTransform::CaptureView(UObject* Data) const
+{
+	// The base transform has no view to prepare, so the widget is configured with the data directly
+
+	return nullptr;
+}
+
+UUIExtensionDataViewPayload* UUIExtensionDataTransform::MakeViewPayload(const TSharedRef<const FUIExtensionDataView>& View, UObject* Outer) const
+{
+	auto* Payload{ NewObject<UUIExtensionDataViewPayload>(Outer) };
+	Payload->SetView(View);
+
+	return Payload;
+}
+
@@ -0,0 +1,104 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "UObject/Interface.h"
+
+#include "UIExtensionDataTransform.generated.h"
+
+
+/**
+ * Plain view of extension data that is prepared outside of the game thread
+ *
+ * Tips:
+ *	Derive from this struct, copy what is needed from the data object in UUIExtensionDataTransform::CaptureView(),
+ *	and do the expensive preparation (formatting, sorting, lookups, etc.) in Build().
+ */
+struct GUIEXT_API FUIExtensionDataView : public TSharedFromThis<FUIExtensionDataView>
+{
+public:
+	virtual ~FUIExtensionDataView() {}
+
+	/**
+	 * Prepares the view on a task graph worker thread.
+	 * Only data owned by this view may be accessed here.
+	 */
+	virtual void Build() {}
+
+};
+
+
+/**
+ * Blueprint visible handle to a view prepared by UUIExtensionDataTransform
+ *
+ * Tips:
+ *	Derive from this class and add BlueprintPure getters that read from the view built by the matching transform.
+ */
+UCLASS(BlueprintType)
+class GUIEXT_API UUIExtensionDataViewPayload : public UObject
+{
+	GENERATED_BODY()
+public:
+	UUIExtensionDataViewPayload() {}
+
+protected:
+	TSharedPtr<const FUIExtensionDataView> View;
+
+public:
+	void SetView(const TSharedRef<const FUIExtensionDataView>& InView) { View = InView; }
+
+	template<typename ViewT = FUIExtensionDataView>
+	const ViewT* GetView() const { return static_cast<const ViewT*>(View.Get()); }
+
+};
+
+
+/**
+ * Optional native stage of UUIExtensionPointWidget that turns extension data into a view before the widget is configured
+ */
+UCLASS(Abstract, EditInlineNew, DefaultToInstanced, CollapseCategories)
+class GUIEXT_API UUIExtensionDataTransform : public UObject
+{
+	GENERATED_BODY()
+public:
+	UUIExtensionDataTransform() {}
+
+public:
+	/**
+	 * Copies the values needed by the view out of the extension data. Called on the game thread.
+	 *
+	 * Tips:
+	 *	Returning null skips the transform and the widget is configured immediately.
+	 */
+	virtual TSharedPtr<FUIExtensionDataView> CaptureView(UObject* Data) const;
+
+	/**
+	 * Wraps the built view for ConfigureWidgetForDataView. Called on the game thread.
+	 *
+	 * Tips:
+	 *	Override to return a payload class that exposes the fields of the view to Blueprint.
+	 */
+	virtual UUIExtensionDataViewPayload* MakeViewPayload(const TSharedRef<const FUIExtensionDataView>& View, UObject* Outer) const;
+
+};
+
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UUIExtensionDataViewReceiver : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Interface for widgets that receive the view prepared by UUIExtensionDataTransform
+ */
+class GUIEXT_API IUIExtensionDataViewReceiver
+{
+	GENERATED_BODY()
+public:
+	/**
+	 * Notifies that the view for the extension data of this widget is ready. Called on the game thread.
+	 */
+	virtual void NativeOnExtensionDataViewReady(const TSharedRef<const FUIExtensionDataView>& View) = 0;
+
+};
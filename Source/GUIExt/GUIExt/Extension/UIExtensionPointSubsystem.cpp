@@ -33,12 +33,12 @@ void UUIExtensionPointSubsystem::AddReferencedObjects(UObject* InThis, FReferenc
 }
 
 
-FUIExtensionPointHandle UUIExtensionPointSubsystem::RegisterExtensionPoint(const FGameplayTag& ExtensionPointTag, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FUIExtensionActionDelegate ExtensionCallback)
+FUIExtensionPointHandle UUIExtensionPointSubsystem::RegisterExtensionPoint(const FGameplayTag& ExtensionPointTag, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FUIExtensionActionDelegate ExtensionCallback, FUIExtensionBatchDelegate BatchCallback)
 {
-	return RegisterExtensionPointForContext(ExtensionPointTag, nullptr, ExtensionPointTagMatchType, AllowedDataClasses, ExtensionCallback);
+	return RegisterExtensionPointForContext(ExtensionPointTag, nullptr, ExtensionPointTagMatchType, AllowedDataClasses, ExtensionCallback, BatchCallback);
 }
 
-FUIExtensionPointHandle UUIExtensionPointSubsystem::RegisterExtensionPointForContext(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FUIExtensionActionDelegate ExtensionCallback)
+FUIExtensionPointHandle UUIExtensionPointSubsystem::RegisterExtensionPointForContext(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FUIExtensionActionDelegate ExtensionCallback, FUIExtensionBatchDelegate BatchCallback)
 {
 	if (!ExtensionPointTag.IsValid())
 	{
@@ -65,6 +65,7 @@ FUIExtensionPointHandle UUIExtensionPointSubsystem::RegisterExtensionPointForCon
 	Entry->ExtensionPointTagMatchType	= ExtensionPointTagMatchType;
 	Entry->AllowedDataClasses			= AllowedDataClasses;
 	Entry->Callback						= MoveTemp(ExtensionCallback);
+	Entry->BatchCallback				= MoveTemp(BatchCallback);
 
 	UE_LOG(LogGameExt_UI, Log, TEXT("Extension Point [%s] Registered"), *ExtensionPointTag.ToString());
 
@@ -167,6 +168,13 @@ void UUIExtensionPointSubsystem::UnregisterExtensionPoint(const FUIExtensionPoin
 		{
 			UE_LOG(LogGameExt_UI, Log, TEXT("Extension Point [%s] Unregistered"), *ExtensionPoint->ExtensionPointTag.ToString());
 
+			// Close any batch still open on this extension point so that its owner does not stay suspended.
+
+			if (BatchedExtensionPoints.Remove(ExtensionPoint) > 0)
+			{
+				ExtensionPoint->BatchCallback.ExecuteIfBound(EUIExtensionBatchAction::End);
+			}
+
 			ListPtr->RemoveSwap(ExtensionPoint);
 
 			if (ListPtr->Num() == 0)
@@ -182,6 +190,43 @@ void UUIExtensionPointSubsystem::UnregisterExtensionPoint(const FUIExtensionPoin
 }
 
 
+void UUIExtensionPointSubsystem::BeginNotificationBatch()
+{
+	++NotificationBatchDepth;
+}
+
+void UUIExtensionPointSubsystem::EndNotificationBatch()
+{
+	if (!ensure(NotificationBatchDepth > 0))
+	{
+		return;
+	}
+
+	if (--NotificationBatchDepth == 0)
+	{
+		// Copy in case there are registrations or removals while handling callbacks
+
+		auto ExtensionPointArray{ MoveTemp(BatchedExtensionPoints) };
+		BatchedExtensionPoints.Reset();
+
+		for (const auto& ExtensionPoint : ExtensionPointArray)
+		{
+			ExtensionPoint->BatchCallback.ExecuteIfBound(EUIExtensionBatchAction::End);
+		}
+	}
+}
+
+void UUIExtensionPointSubsystem::AddExtensionPointToBatch(const TSharedPtr<FUIExtensionPoint>& ExtensionPoint)
+{
+	if ((NotificationBatchDepth > 0) && ExtensionPoint->BatchCallback.IsBound() && !BatchedExtensionPoints.Contains(ExtensionPoint))
+	{
+		BatchedExtensionPoints.Add(ExtensionPoint);
+
+		ExtensionPoint->BatchCallback.Execute(EUIExtensionBatchAction::Begin);
+	}
+}
+
+
 FUIExtensionPointHandle UUIExtensionPointSubsystem::K2_RegisterExtensionPoint(FGameplayTag ExtensionPointTag, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FUIExtensionPointActionDelegate ExtensionCallback)
 {
 	return RegisterExtensionPoint(
@@ -239,6 +284,10 @@ FUIExtensionHandle UUIExtensionPointSubsystem::K2_RegisterExtensionAsDataForCont
 
 void UUIExtensionPointSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUIExtensionPoint>& ExtensionPoint)
 {
+	// All existing extensions arrive at once, so deliver them to the new extension point as one batch.
+
+	FUIExtensionNotificationBatchScope BatchScope(this);
+
 	for (auto Tag{ ExtensionPoint->ExtensionPointTag }; Tag.IsValid(); Tag = Tag.RequestDirectParent())
 	{
 		if (const auto* ListPtr{ ExtensionMap.Find(Tag) })
@@ -253,6 +302,8 @@ void UUIExtensionPointSubsystem::NotifyExtensionPointOfExtensions(TSharedPtr<FUI
 				{
 					auto Request{ CreateExtensionRequest(Extension) };
 
+					AddExtensionPointToBatch(ExtensionPoint);
+
 					ExtensionPoint->Callback.ExecuteIfBound(EUIExtensionAction::Added, Request);
 				}
 			}
@@ -285,6 +336,8 @@ void UUIExtensionPointSubsystem::NotifyExtensionPointsOfExtension(EUIExtensionAc
 					{
 						auto Request{ CreateExtensionRequest(Extension) };
 
+						AddExtensionPointToBatch(ExtensionPoint);
+
 						ExtensionPoint->Callback.ExecuteIfBound(Action, Request);
 					}
 				}
@@ -307,3 +360,24 @@ FUIExtensionRequest UUIExtensionPointSubsystem::CreateExtensionRequest(const TSh
 
 	return Request;
 }
+
+
+///////////////////////////////////////////////////////////
+// FUIExtensionNotificationBatchScope
+
+FUIExtensionNotificationBatchScope::FUIExtensionNotificationBatchScope(UUIExtensionPointSubsystem* InExtensionSubsystem)
+	: ExtensionSubsystem(InExtensionSubsystem)
+{
+	if (auto* ExtensionSubsystemPtr{ ExtensionSubsystem.Get() })
+	{
+		ExtensionSubsystemPtr->BeginNotificationBatch();
+	}
+}
+
+FUIExtensionNotificationBatchScope::~FUIExtensionNotificationBatchScope()
+{
+	if (auto* ExtensionSubsystemPtr{ ExtensionSubsystem.Get() })
+	{
+		ExtensionSubsystemPtr->EndNotificationBatch();
+	}
+}
@@ -36,9 +36,19 @@ private:
 	typedef TArray<TSharedPtr<FUIExtension>> FExtensionList;
 	TMap<FGameplayTag, FExtensionList> ExtensionMap;
 
+	//
+	// Depth of the currently open notification batches
+	//
+	int32 NotificationBatchDepth{ 0 };
+
+	//
+	// Extension points that have been told a batch has begun and are waiting for it to end
+	//
+	FExtensionPointList BatchedExtensionPoints;
+
 public:
-	FUIExtensionPointHandle RegisterExtensionPoint(const FGameplayTag& ExtensionPointTag, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FUIExtensionActionDelegate ExtensionCallback);
-	FUIExtensionPointHandle RegisterExtensionPointForContext(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FUIExtensionActionDelegate ExtensionCallback);
+	FUIExtensionPointHandle RegisterExtensionPoint(const FGameplayTag& ExtensionPointTag, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FUIExtensionActionDelegate ExtensionCallback, FUIExtensionBatchDelegate BatchCallback = FUIExtensionBatchDelegate());
+	FUIExtensionPointHandle RegisterExtensionPointForContext(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FUIExtensionActionDelegate ExtensionCallback, FUIExtensionBatchDelegate BatchCallback = FUIExtensionBatchDelegate());
 
 	FUIExtensionHandle RegisterExtensionAsWidget(const FGameplayTag& ExtensionPointTag, TSubclassOf<UUserWidget> WidgetClass, int32 Priority);
 	FUIExtensionHandle RegisterExtensionAsWidgetForContext(const FGameplayTag& ExtensionPointTag, UObject* ContextObject, TSubclassOf<UUserWidget> WidgetClass, int32 Priority);
@@ -50,6 +60,17 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "UI Extension")
 	void UnregisterExtensionPoint(const FUIExtensionPointHandle& ExtensionPointHandle);
 
+	/**
+	 * Opens a notification batch. 
+	 * Every extension point notified until the matching EndNotificationBatch() receives a single Begin/End pair around its changes.
+	 */
+	void BeginNotificationBatch();
+
+	/**
+	 * Closes a notification batch and notifies the end of the batch to the extension points involved when the outermost batch closes.
+	 */
+	void EndNotificationBatch();
+
 protected:
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category="UI Extension", meta = (DisplayName = "Register Extension Point", GameplayTagFilter = "UI.Extension"))
 	FUIExtensionPointHandle K2_RegisterExtensionPoint(FGameplayTag ExtensionPointTag, EUIExtensionPointMatch ExtensionPointTagMatchType, const TArray<UClass*>& AllowedDataClasses, FUIExtensionPointActionDelegate ExtensionCallback);
@@ -81,4 +102,22 @@ protected:
 
 	FUIExtensionRequest CreateExtensionRequest(const TSharedPtr<FUIExtension>& Extension);
 
+	void AddExtensionPointToBatch(const TSharedPtr<FUIExtensionPoint>& ExtensionPoint);
+
+};
+
+
+/**
+ * Scope that groups all extension changes made inside it into one batch per extension point
+ */
+struct GUIEXT_API FUIExtensionNotificationBatchScope
+{
+	UE_NONCOPYABLE(FUIExtensionNotificationBatchScope);
+public:
+	explicit FUIExtensionNotificationBatchScope(UUIExtensionPointSubsystem* InExtensionSubsystem);
+	~FUIExtensionNotificationBatchScope();
+
+private:
+	TWeakObjectPtr<UUIExtensionPointSubsystem> ExtensionSubsystem;
+
 };
@@ -45,6 +45,23 @@ enum class EUIExtensionAction : uint8
 DECLARE_DELEGATE_TwoParams(FUIExtensionActionDelegate, EUIExtensionAction Action, const FUIExtensionRequest& Request);
 
 
+/**
+ * Phase of a batch of extension changes delivered to an extension point
+ */
+enum class EUIExtensionBatchAction : uint8
+{
+	Begin,
+
+	End
+};
+
+
+/**
+ * Delegate to notify that a batch of extension changes begins or ends on UIExtensionPoint
+ */
+DECLARE_DELEGATE_OneParam(FUIExtensionBatchDelegate, EUIExtensionBatchAction Action);
+
+
 /**
  * Data of what has been added to the UIExtensionPoint
  */
@@ -78,6 +95,8 @@ public:
 
 	FUIExtensionActionDelegate Callback;
 
+	FUIExtensionBatchDelegate BatchCallback;
+
 public:
 	/**
 	 * Tests if the extension and the extension point match up, if they do then this extension point should learn about this extension.
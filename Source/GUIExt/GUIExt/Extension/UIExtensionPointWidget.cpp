@@ -3,11 +3,16 @@
 #include "UIExtensionPointWidget.h"
 
 #include "Extension/UIExtensionPointSubsystem.h"
+#include "Extension/UIExtensionDataTransform.h"
+#include "UIManagerSubsystem.h"
 #include "GUIExtLogs.h"
 
+#include "Async/Async.h"
 #include "Editor/WidgetCompilerLog.h"
+#include "Engine/GameInstance.h"
 #include "Misc/UObjectToken.h"
 #include "Widgets/SOverlay.h"
+#include "Widgets/Layout/SBox.h"
 #include "Widgets/Text/STextBlock.h"
 #include "GameFramework/PlayerState.h"
 
@@ -50,6 +55,8 @@ void UUIExtensionPointWidget::ReleaseSlateResources(bool bReleaseChildren)
 {
 	ResetExtensionPoint();
 
+	MyEntryPanelContainer.Reset();
+
 	Super::ReleaseSlateResources(bReleaseChildren);
 }
 
@@ -86,13 +93,65 @@ TSharedRef<SWidget> UUIExtensionPointWidget::RebuildWidget()
 	}
 	else
 	{
-		return Super::RebuildWidget();
+		MyEntryPanelContainer = SNew(SBox)
+			[
+				Super::RebuildWidget()
+			];
+
+		return MyEntryPanelContainer.ToSharedRef();
+	}
+}
+
+
+void UUIExtensionPointWidget::BeginExtensionBatch()
+{
+	++ExtensionBatchDepth;
+}
+
+void UUIExtensionPointWidget::EndExtensionBatch()
+{
+	if (!ensure(ExtensionBatchDepth > 0))
+	{
+		return;
+	}
+
+	if (--ExtensionBatchDepth == 0)
+	{
+		auto Requests{ MoveTemp(PendingBatchRequests) };
+		PendingBatchRequests.Reset();
+
+		if (Requests.IsEmpty())
+		{
+			return;
+		}
+
+		// Rebuild the panel outside the widget tree so that creating and removing entries does not invalidate anything,
+		// then swap it in to send a single layout invalidation for the whole batch
+
+		TSharedPtr<SWidget> NewEntryPanel;
+		if (MyEntryPanelContainer.IsValid())
+		{
+			NewEntryPanel = Super::RebuildWidget();
+		}
+
+		for (const auto& KVP : Requests)
+		{
+			ApplyExtensionRequest(KVP.Key, KVP.Value);
+		}
+
+		if (NewEntryPanel.IsValid())
+		{
+			MyEntryPanelContainer->SetContent(NewEntryPanel.ToSharedRef());
+		}
 	}
 }
 
 
 void UUIExtensionPointWidget::ResetExtensionPoint()
 {
+	PendingBatchRequests.Reset();
+	PendingDataTransforms.Reset();
+
 	ResetInternal();
 
 	ExtensionMapping.Reset();
@@ -118,7 +177,8 @@ void UUIExtensionPointWidget::RegisterExtensionPoint()
 				ExtensionPointTag, 
 				ExtensionPointTagMatch, 
 				AllowedDataClasses,
-				FUIExtensionActionDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension)
+				FUIExtensionActionDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension),
+				FUIExtensionBatchDelegate::CreateUObject(this, &ThisClass::OnExtensionBatch)
 			)
 		);
 
@@ -128,13 +188,59 @@ void UUIExtensionPointWidget::RegisterExtensionPoint()
 				GetOwningLocalPlayer(), 
 				ExtensionPointTagMatch, 
 				AllowedDataClasses,
-				FUIExtensionActionDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension)
+				FUIExtensionActionDelegate::CreateUObject(this, &ThisClass::OnAddOrRemoveExtension),
+				FUIExtensionBatchDelegate::CreateUObject(this, &ThisClass::OnExtensionBatch)
 			)
 		);
 	}
 }
 
 void UUIExtensionPointWidget::OnAddOrRemoveExtension(EUIExtensionAction Action, const FUIExtensionRequest& Request)
+{
+	if (IsInExtensionBatch())
+	{
+		// An extension added and removed within the same batch never needs an entry.
+
+		if (Action == EUIExtensionAction::Removed)
+		{
+			const auto PendingIndex
+			{
+				PendingBatchRequests.IndexOfByPredicate(
+					[&Request](const TPair<EUIExtensionAction, FUIExtensionRequest>& Pending)
+					{
+						return (Pending.Key == EUIExtensionAction::Added) && (Pending.Value.ExtensionHandle == Request.ExtensionHandle);
+					}
+				)
+			};
+
+			if (PendingIndex != INDEX_NONE)
+			{
+				PendingBatchRequests.RemoveAt(PendingIndex);
+				return;
+			}
+		}
+
+		PendingBatchRequests.Emplace(Action, Request);
+	}
+	else
+	{
+		ApplyExtensionRequest(Action, Request);
+	}
+}
+
+void UUIExtensionPointWidget::OnExtensionBatch(EUIExtensionBatchAction Action)
+{
+	if (Action == EUIExtensionBatchAction::Begin)
+	{
+		BeginExtensionBatch();
+	}
+	else
+	{
+		EndExtensionBatch();
+	}
+}
+
+void UUIExtensionPointWidget::ApplyExtensionRequest(EUIExtensionAction Action, const FUIExtensionRequest& Request)
 {
 	if (Action == EUIExtensionAction::Added)
 	{
@@ -161,7 +267,12 @@ void UUIExtensionPointWidget::OnAddOrRemoveExtension(EUIExtensionAction Action,
 					{
 						ExtensionMapping.Add(Request.ExtensionHandle, Widget);
 
-						ConfigureWidgetForData.ExecuteIfBound(Widget, Data);
+						// The entry is created right away to keep its position, the configuration waits for the transformed view.
+
+						if (!StartDataTransform(Request.ExtensionHandle, Data))
+						{
+							ConfigureWidgetForData.ExecuteIfBound(Widget, Data);
+						}
 					}
 				}
 			}
@@ -169,6 +280,8 @@ void UUIExtensionPointWidget::OnAddOrRemoveExtension(EUIExtensionAction Action,
 	}
 	else
 	{
+		PendingDataTransforms.Remove(Request.ExtensionHandle);
+
 		if (auto Extension{ ExtensionMapping.FindRef(Request.ExtensionHandle) })
 		{
 			RemoveEntryInternal(Extension);
@@ -178,4 +291,102 @@ void UUIExtensionPointWidget::OnAddOrRemoveExtension(EUIExtensionAction Action,
 	}
 }
 
+
+bool UUIExtensionPointWidget::StartDataTransform(const FUIExtensionHandle& ExtensionHandle, UObject* Data)
+{
+	if (!DataTransform)
+	{
+		return false;
+	}
+
+	auto View{ DataTransform->CaptureView(Data) };
+
+	if (!View.IsValid())
+	{
+		return false;
+	}
+
+	const auto Serial{ ++LastDataTransformSerial };
+	PendingDataTransforms.Add(ExtensionHandle, Serial);
+
+	auto WeakThis{ TWeakObjectPtr<ThisClass>(this) };
+	auto WeakData{ TWeakObjectPtr<UObject>(Data) };
+
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask,
+		[WeakThis, WeakData, ExtensionHandle, Serial, View]()
+		{
+			View->Build();
+
+			AsyncTask(ENamedThreads::GameThread,
+				[WeakThis, WeakData, ExtensionHandle, Serial, View]()
+				{
+					auto* PointWidget{ WeakThis.Get() };
+
+					if (!PointWidget)
+					{
+						return;
+					}
+
+					auto DeliverView
+					{
+						[WeakThis, WeakData, ExtensionHandle, Serial, View]()
+						{
+							if (auto* This{ WeakThis.Get() })
+							{
+								This->HandleDataTransformComplete(ExtensionHandle, Serial, View.ToSharedRef(), WeakData.Get());
+							}
+						}
+					};
+
+					// Configuring the widget is spread over frames with the rest of the deferred UI work
+
+					static const auto NAME_DeliverExtensionDataView{ FName(TEXT("DeliverExtensionDataView")) };
+
+					if (auto* UIManager{ UGameInstance::GetSubsystem<UUIManagerSubsystem>(PointWidget->GetGameInstance()) })
+					{
+						UIManager->GetFrameScheduler().Submit(EUITaskPriority::Normal, MoveTemp(DeliverView), NAME_DeliverExtensionDataView);
+					}
+					else
+					{
+						DeliverView();
+					}
+				}
+			);
+		}
+	);
+
+	return true;
+}
+
+void UUIExtensionPointWidget::HandleDataTransformComplete(const FUIExtensionHandle& ExtensionHandle, uint32 Serial, const TSharedRef<const FUIExtensionDataView>& View, UObject* Data)
+{
+	// Ignore results for extensions that have been removed or added again while the view was being built.
+
+	if (PendingDataTransforms.FindRef(ExtensionHandle) != Serial)
+	{
+		return;
+	}
+
+	PendingDataTransforms.Remove(ExtensionHandle);
+
+	if (auto Widget{ ExtensionMapping.FindRef(ExtensionHandle) })
+	{
+		if (auto* Receiver{ Cast<IUIExtensionDataViewReceiver>(Widget) })
+		{
+			Receiver->NativeOnExtensionDataViewReady(View);
+		}
+
+		// Blueprint receives the view through the payload built by the transform
+
+		if (ConfigureWidgetForDataView.IsBound() && DataTransform)
+		{
+			ConfigureWidgetForDataView.Execute(Widget, Data, DataTransform->MakeViewPayload(View, Widget));
+		}
+		else
+		{
+			ConfigureWidgetForData.ExecuteIfBound(Widget, Data);
+		}
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
@@ -10,6 +10,10 @@
 
 class UGFCLocalPlayer;
 class APlayerState;
+class UUIExtensionDataTransform;
+class UUIExtensionDataViewPayload;
+class SBox;
+struct FUIExtensionDataView;
 
 
 /**
@@ -29,6 +33,7 @@ public:
 public:
 	DECLARE_DYNAMIC_DELEGATE_RetVal_OneParam(TSubclassOf<UUserWidget>, FGetWidgetClassForDataDelegate, UObject*, DataItem);
 	DECLARE_DYNAMIC_DELEGATE_TwoParams(FConfigureWidgetForDataDelegate, UUserWidget*, Widget, UObject*, DataItem);
+	DECLARE_DYNAMIC_DELEGATE_ThreeParams(FConfigureWidgetForDataViewDelegate, UUserWidget*, Widget, UObject*, DataItem, UUIExtensionDataViewPayload*, View);
 
 protected:
 	//
@@ -52,18 +57,76 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "UI Extension", meta = (IsBindableEvent = "True"))
 	FConfigureWidgetForDataDelegate ConfigureWidgetForData;
 
+	//
+	// Called instead of ConfigureWidgetForData when DataTransform has built a view for the data
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "UI Extension", meta = (IsBindableEvent = "True"))
+	FConfigureWidgetForDataViewDelegate ConfigureWidgetForDataView;
+
+	//
+	// Optional native stage that prepares the data on a worker thread before ConfigureWidgetForData is called
+	//
+	UPROPERTY(EditAnywhere, Instanced, BlueprintReadOnly, Category = "UI Extension")
+	TObjectPtr<UUIExtensionDataTransform> DataTransform;
+
 	TArray<FUIExtensionPointHandle> ExtensionPointHandles;
 
 	UPROPERTY(Transient)
 	TMap<FUIExtensionHandle, TObjectPtr<UUserWidget>> ExtensionMapping;
 
+	//
+	// Depth of the currently open extension batches
+	//
+	int32 ExtensionBatchDepth{ 0 };
+
+	//
+	// Extension changes received while a batch is open, applied in order when the batch closes
+	//
+	TArray<TPair<EUIExtensionAction, FUIExtensionRequest>> PendingBatchRequests;
+
+	//
+	// Holds the entry panel so that a closed batch can swap in a panel rebuilt outside the widget tree
+	//
+	TSharedPtr<SBox> MyEntryPanelContainer;
+
+	//
+	// Serial number of the data transform in flight for each extension, used to drop results that are no longer wanted
+	//
+	TMap<FUIExtensionHandle, uint32> PendingDataTransforms;
+
+	uint32 LastDataTransformSerial{ 0 };
+
 public:
 	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
 	virtual TSharedRef<SWidget> RebuildWidget() override;
 
+	/**
+	 * Defers the extension changes received until the matching EndExtensionBatch().
+	 * 
+	 * Tips:
+	 *	Called automatically when the extension subsystem delivers changes in batches.
+	 *	An extension added and removed within the same batch never creates an entry.
+	 */
+	void BeginExtensionBatch();
+
+	/**
+	 * Applies the changes received during the batch in order when the outermost batch closes
+	 * 
+	 * Tips:
+	 *	The entries are applied to a panel that is not in the widget tree yet,
+	 *	which is then swapped in with a single layout invalidation.
+	 */
+	void EndExtensionBatch();
+
+	bool IsInExtensionBatch() const { return ExtensionBatchDepth > 0; }
+
 private:
 	void ResetExtensionPoint();
 	void RegisterExtensionPoint();
 	void OnAddOrRemoveExtension(EUIExtensionAction Action, const FUIExtensionRequest& Request);
+	void OnExtensionBatch(EUIExtensionBatchAction Action);
+	void ApplyExtensionRequest(EUIExtensionAction Action, const FUIExtensionRequest& Request);
+	bool StartDataTransform(const FUIExtensionHandle& ExtensionHandle, UObject* Data);
+	void HandleDataTransformComplete(const FUIExtensionHandle& ExtensionHandle, uint32 Serial, const TSharedRef<const FUIExtensionDataView>& View, UObject* Data);
 
 };
@@ -2,6 +2,9 @@
 
 #include "ActivatableWidget.h"
 
+#include "Input/UIInputConfigSubsystem.h"
+#include "UIDeveloperSettings.h"
+
 #include "Editor/WidgetCompilerLog.h"
 #include "CommonInputModeTypes.h"
 #include "Input/UIActionBindingHandle.h"
@@ -39,6 +42,16 @@ void UActivatableWidget::ValidateCompiledWidgetTree(const UWidgetTree& Blueprint
 
 
 TOptional<FUIInputConfig> UActivatableWidget::GetDesiredInputConfig() const
+{
+	if (GetDefault<UUIDeveloperSettings>()->bArbitrateInputConfig)
+	{
+		return TOptional<FUIInputConfig>();
+	}
+
+	return ResolveDesiredInputConfig();
+}
+
+TOptional<FUIInputConfig> UActivatableWidget::ResolveDesiredInputConfig() const
 {
 	switch (InputMode)
 	{
@@ -55,4 +68,54 @@ TOptional<FUIInputConfig> UActivatableWidget::GetDesiredInputConfig() const
 	return TOptional<FUIInputConfig>();
 }
 
+void UActivatableWidget::NativeOnActivated()
+{
+	Super::NativeOnActivated();
+
+	if (GetDefault<UUIDeveloperSettings>()->bArbitrateInputConfig)
+	{
+		if (auto* InputConfigSubsystem{ UUIInputConfigSubsystem::Get(GetOwningLocalPlayer()) })
+		{
+			InputConfigSubsystem->RegisterActiveWidget(this);
+		}
+	}
+}
+
+void UActivatableWidget::NativeOnDeactivated()
+{
+	if (auto* InputConfigSubsystem{ UUIInputConfigSubsystem::Get(GetOwningLocalPlayer()) })
+	{
+		InputConfigSubsystem->UnregisterActiveWidget(this);
+	}
+
+	Super::NativeOnDeactivated();
+}
+
+
+void UActivatableWidget::NativeOnWarmReuse()
+{
+	BP_OnWarmReuse();
+}
+
+void UActivatableWidget::NativeOnRestoredFromEviction()
+{
+	BP_OnRestoredFromEviction();
+}
+
+
+void UActivatableWidget::SetIsCovered(bool bNewIsCovered)
+{
+	if (bIsCovered != bNewIsCovered)
+	{
+		bIsCovered = bNewIsCovered;
+
+		NativeOnCoveredChanged();
+	}
+}
+
+void UActivatableWidget::NativeOnCoveredChanged()
+{
+	BP_OnCoveredChanged(bIsCovered);
+}
+
 #undef LOCTEXT_NAMESPACE
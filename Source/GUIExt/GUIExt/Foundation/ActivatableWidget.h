@@ -48,8 +48,79 @@ protected:
 	//
 	UPROPERTY(EditDefaultsOnly, Category = "Input")
 	EMouseCaptureMode GameMouseCaptureMode = EMouseCaptureMode::CapturePermanently;
+
+	//
+	// If true, this widget hides everything on the layers below it while it is displayed, so they can stop ticking and animating
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Occlusion")
+	bool bIsFullscreenOpaque{ false };
+
+private:
+	bool bIsCovered{ false };
 	
 public:
 	virtual TOptional<FUIInputConfig> GetDesiredInputConfig() const override;
 
+	/**
+	 * Returns the input config this widget wants while it is activated.
+	 * 
+	 * Tips:
+	 *	When input config arbitration is enabled, CommonUI no longer receives this config and the input config subsystem applies it instead.
+	 */
+	virtual TOptional<FUIInputConfig> ResolveDesiredInputConfig() const;
+
+protected:
+	virtual void NativeOnActivated() override;
+	virtual void NativeOnDeactivated() override;
+
+public:
+
+	/**
+	 * Notifies that this instance is about to be pushed again from the warm cache of the layout.
+	 * 
+	 * Tips:
+	 *	Reset any state left over from the previous time this widget was shown.
+	 */
+	virtual void NativeOnWarmReuse();
+
+protected:
+	UFUNCTION(BlueprintImplementableEvent, Category = "Warm Cache", meta = (DisplayName = "On Warm Reuse"))
+	void BP_OnWarmReuse();
+
+public:
+	/**
+	 * Notifies that this instance was recreated after being evicted from its layer stack and its SaveGame properties have been restored.
+	 * 
+	 * Tips:
+	 *	Mark the properties that describe the state of the screen (selected tab, scroll offset, etc.) with SaveGame to keep them.
+	 */
+	virtual void NativeOnRestoredFromEviction();
+
+protected:
+	UFUNCTION(BlueprintImplementableEvent, Category = "Eviction", meta = (DisplayName = "On Restored From Eviction"))
+	void BP_OnRestoredFromEviction();
+
+public:
+	bool IsFullscreenOpaque() const { return bIsFullscreenOpaque; }
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Occlusion")
+	bool IsCovered() const { return bIsCovered; }
+
+	/**
+	 * Sets whether this widget is hidden by another widget, either higher in its own stack or on a higher layer
+	 */
+	void SetIsCovered(bool bNewIsCovered);
+
+protected:
+	/**
+	 * Notifies that this widget has been covered or uncovered.
+	 * 
+	 * Tips:
+	 *	Pause timers and latent work owned by this widget here, the layout already stops its ticks and animations.
+	 */
+	virtual void NativeOnCoveredChanged();
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Occlusion", meta = (DisplayName = "On Covered Changed"))
+	void BP_OnCoveredChanged(bool bNewIsCovered);
+
 };
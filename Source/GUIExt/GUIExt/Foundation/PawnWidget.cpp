@@ -48,18 +48,24 @@ APawn* UPawnWidget::GetCachedPawn()
 
 void UPawnWidget::ListenPawnChange()
 {
-	auto* PC{ GetOwningPlayer() };
-	check(PC);
+	// Layouts created before the controller exists listen once they are rebound
 
-	PC->OnPossessedPawnChanged.AddDynamic(this, &ThisClass::HandlePawnChange);
+	if (auto* PC{ GetOwningPlayer() })
+	{
+		PC->OnPossessedPawnChanged.AddUniqueDynamic(this, &ThisClass::HandlePawnChange);
+
+		ListenedPlayerController = PC;
+	}
 }
 
 void UPawnWidget::UnlistenPawnChange()
 {
-	if (auto* PC{ GetOwningPlayer() })
+	if (auto* PC{ ListenedPlayerController.Get() })
 	{
 		PC->OnPossessedPawnChanged.RemoveDynamic(this, &ThisClass::HandlePawnChange);
 	}
+
+	ListenedPlayerController.Reset();
 }
 
 void UPawnWidget::HandlePawnChange(APawn* OldPawn, APawn* NewPawn)
@@ -68,3 +74,17 @@ void UPawnWidget::HandlePawnChange(APawn* OldPawn, APawn* NewPawn)
 
 	OnPawnChanged(OldPawn, NewPawn);
 }
+
+
+void UPawnWidget::NativeOnPlayerControllerRebound(APlayerController* OldPlayerController, APlayerController* NewPlayerController)
+{
+	UnlistenPawnChange();
+	ListenPawnChange();
+
+	auto* NewPawn{ NewPlayerController ? NewPlayerController->GetPawn() : nullptr };
+
+	if (OwningPawn.Get() != NewPawn)
+	{
+		HandlePawnChange(OwningPawn.Get(), NewPawn);
+	}
+}
@@ -3,10 +3,12 @@
 #pragma once
 
 #include "Blueprint/UserWidget.h"
+#include "Foundation/UIPlayerContextReceiver.h"
 
 #include "PawnWidget.generated.h"
 
 class APawn;
+class APlayerController;
 
 
 /**
@@ -16,7 +18,7 @@ class APawn;
  *	This can be used for widgets that display Pawn information (e.g. health bar, etc.)
  */
 UCLASS(Abstract, Blueprintable)
-class GUIEXT_API UPawnWidget : public UUserWidget
+class GUIEXT_API UPawnWidget : public UUserWidget, public IUIPlayerContextReceiver
 {
 	GENERATED_BODY()
 public:
@@ -35,6 +37,11 @@ protected:
 	UPROPERTY(Transient)
 	TWeakObjectPtr<APawn> OwningPawn{ nullptr };
 
+	//
+	// PlayerController whose pawn changes are listened to
+	//
+	TWeakObjectPtr<APlayerController> ListenedPlayerController{ nullptr };
+
 public:
 	/**
 	 * Get the Pawn owned by the PlayerController that owns this widget
@@ -69,4 +76,7 @@ protected:
 	void OnPawnChanged(APawn* OldPawn, APawn* NewPawn);
 	virtual void OnPawnChanged_Implementation(APawn* OldPawn, APawn* NewPawn) {}
 
+public:
+	virtual void NativeOnPlayerControllerRebound(APlayerController* OldPlayerController, APlayerController* NewPlayerController) override;
+
 };
@@ -0,0 +1,33 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "UObject/Interface.h"
+
+#include "UIPlayerContextReceiver.generated.h"
+
+class APlayerController;
+
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UUIPlayerContextReceiver : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Interface for widgets that hold on to their owning player controller
+ */
+class GUIEXT_API IUIPlayerContextReceiver
+{
+	GENERATED_BODY()
+public:
+	/**
+	 * Notifies that the root layout holding this widget was rebound to another player controller without being rebuilt.
+	 * 
+	 * Tips:
+	 *	Move anything bound to the old controller (delegates, cached pawn, etc.) to the new one here.
+	 */
+	virtual void NativeOnPlayerControllerRebound(APlayerController* OldPlayerController, APlayerController* NewPlayerController) = 0;
+
+};
@@ -4,6 +4,8 @@
 
 #include "Extension/UIExtensionPointSubsystem.h"
 #include "UIFunctionLibrary.h"
+#include "UIManagerSubsystem.h"
+#include "UIPolicy.h"
 
 #include "InitState/InitStateComponent.h"
 #include "Player/GFCPlayerController.h"
@@ -130,6 +132,8 @@ void UGameFeatureAction_AddWidgets::Reset(FPerContextData& ActiveData)
 	}
 
 	ActiveData.ExtensionHandles.Reset();
+
+	ReleaseSharedClasses(ActiveData);
 }
 
 void UGameFeatureAction_AddWidgets::HandleActorExtension(AActor* Actor, FName EventName, FGameFeatureStateChangeContext ChangeContext)
@@ -152,23 +156,44 @@ void UGameFeatureAction_AddWidgets::AddWidgets(AActor* Actor, FPerContextData& A
 
 	if (PC && PC->IsLocalPlayerController() && PC->GetPlayerState<APlayerState>())
 	{
-		if (!ActiveData.ExtensionHandles.IsEmpty() || !ActiveData.LayoutsAdded.IsEmpty())
+		if (!ActiveData.ExtensionHandles.IsEmpty() || !ActiveData.LayoutsAdded.IsEmpty() || !ActiveData.HeadlessLayoutsAdded.IsEmpty())
 		{
 			return;
 		}
 
 		if (auto* LocalPlayer{ PC->GetLocalPlayer() })
 		{
+			// Every local player after the first reuses the class loaded for the first one
+
+			for (const auto& Entry : Layout)
+			{
+				AcquireSharedClass(LocalPlayer, Entry.LayoutClass.ToSoftObjectPath(), ActiveData);
+			}
+
+			for (const auto& Entry : Widgets)
+			{
+				AcquireSharedClass(LocalPlayer, Entry.WidgetClass.ToSoftObjectPath(), ActiveData);
+			}
+
 			for (const auto& Entry : Layout)
 			{
 				if (auto ConcreteWidgetClass{ Entry.LayoutClass.Get() })
 				{
-					ActiveData.LayoutsAdded.Add(UUIFunctionLibrary::PushContentToLayer_ForPlayer(LocalPlayer, Entry.LayerID, ConcreteWidgetClass));
+					if (auto* AddedLayout{ UUIFunctionLibrary::PushContentToLayer_ForPlayer(LocalPlayer, Entry.LayerID, ConcreteWidgetClass) })
+					{
+						ActiveData.LayoutsAdded.Add(AddedLayout);
+					}
+					else
+					{
+						ActiveData.HeadlessLayoutsAdded.Emplace(Entry.LayerID, Entry.LayoutClass);
+					}
 				}
 			}
 
 			auto* ExtensionSubsystem{ PC->GetWorld()->GetSubsystem<UUIExtensionPointSubsystem>() };
 
+			FUIExtensionNotificationBatchScope BatchScope(ExtensionSubsystem);
+
 			for (const auto& Entry : Widgets)
 			{
 				ActiveData.ExtensionHandles.Add(ExtensionSubsystem->RegisterExtensionAsWidgetForContext(Entry.SlotID, LocalPlayer, Entry.WidgetClass.Get(), -1));
@@ -193,13 +218,58 @@ void UGameFeatureAction_AddWidgets::RemoveWidgets(AActor* Actor, FPerContextData
 
 		ActiveData.LayoutsAdded.Reset();
 
+		if (auto* LocalPlayer{ PC->GetLocalPlayer() })
+		{
+			for (const auto& KVP : ActiveData.HeadlessLayoutsAdded)
+			{
+				UUIFunctionLibrary::PopContentFromLayer_ForPlayer(LocalPlayer, KVP.Key, KVP.Value);
+			}
+		}
+
+		ActiveData.HeadlessLayoutsAdded.Reset();
+
+		FUIExtensionNotificationBatchScope BatchScope(PC->GetWorld()->GetSubsystem<UUIExtensionPointSubsystem>());
+
 		for (auto& Handle : ActiveData.ExtensionHandles)
 		{
 			Handle.Unregister();
 		}
 
 		ActiveData.ExtensionHandles.Reset();
+
+		ReleaseSharedClasses(ActiveData);
+	}
+}
+
+void UGameFeatureAction_AddWidgets::AcquireSharedClass(ULocalPlayer* LocalPlayer, const FSoftObjectPath& ClassPath, FPerContextData& ActiveData)
+{
+	auto* GameInstance{ LocalPlayer ? LocalPlayer->GetGameInstance() : nullptr };
+	auto* UIManager{ GameInstance ? GameInstance->GetSubsystem<UUIManagerSubsystem>() : nullptr };
+
+	if (auto* Policy{ UIManager ? UIManager->GetCurrentUIPolicy() : nullptr })
+	{
+		if (Policy->AcquireSharedWidgetClass(LocalPlayer, ClassPath).IsValid())
+		{
+			ActiveData.SharedClasses.Emplace(LocalPlayer, ClassPath);
+		}
 	}
 }
 
+void UGameFeatureAction_AddWidgets::ReleaseSharedClasses(FPerContextData& ActiveData)
+{
+	for (const auto& SharedClass : ActiveData.SharedClasses)
+	{
+		auto* LocalPlayer{ SharedClass.Key.Get() };
+		auto* GameInstance{ LocalPlayer ? LocalPlayer->GetGameInstance() : nullptr };
+		auto* UIManager{ GameInstance ? GameInstance->GetSubsystem<UUIManagerSubsystem>() : nullptr };
+
+		if (auto* Policy{ UIManager ? UIManager->GetCurrentUIPolicy() : nullptr })
+		{
+			Policy->ReleaseSharedWidgetClass(LocalPlayer, SharedClass.Value);
+		}
+	}
+
+	ActiveData.SharedClasses.Reset();
+}
+
 #undef LOCTEXT_NAMESPACE
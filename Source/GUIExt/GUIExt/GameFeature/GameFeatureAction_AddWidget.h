@@ -89,6 +89,16 @@ private:
 		TArray<TSharedPtr<FComponentRequestHandle>> ComponentRequests;
 		TArray<TWeakObjectPtr<UCommonActivatableWidget>> LayoutsAdded;
 		TArray<FUIExtensionHandle> ExtensionHandles;
+
+		//
+		// Layouts recorded on the headless layout of the player, which have no widget to deactivate
+		//
+		TArray<TPair<FGameplayTag, TSoftClassPtr<UCommonActivatableWidget>>> HeadlessLayoutsAdded;
+
+		//
+		// Widget classes acquired from the UI policy, shared with the other local players
+		//
+		TArray<TPair<TWeakObjectPtr<ULocalPlayer>, FSoftObjectPath>> SharedClasses;
 	};
 
 	TMap<FGameFeatureStateChangeContext, FPerContextData> ContextData;
@@ -118,4 +128,7 @@ private:
 	void AddWidgets(AActor* Actor, FPerContextData& ActiveData);
 	void RemoveWidgets(AActor* Actor, FPerContextData& ActiveData);
 
+	void AcquireSharedClass(ULocalPlayer* LocalPlayer, const FSoftObjectPath& ClassPath, FPerContextData& ActiveData);
+	void ReleaseSharedClasses(FPerContextData& ActiveData);
+
 };
@@ -26,11 +26,18 @@ void UHUDLayout::NativeOnInitialized()
 
 	if (ICommonInputModule::GetSettings().IsEnhancedInputSupportEnabled())
 	{
-		if (!EscapeMenuInputAction.IsNull())
+		if (EscapeMenuInputAction.IsValid())
 		{
-			auto* InputAction{ EscapeMenuInputAction.IsValid() ? EscapeMenuInputAction.Get() : EscapeMenuInputAction.LoadSynchronous() };
+			HandleEscapeMenuInputActionLoaded();
+		}
+		else if (!EscapeMenuInputAction.IsNull())
+		{
+			// Bind once the action is streamed in instead of blocking the creation of the HUD
 
-			RegisterUIActionBinding(FBindUIActionArgs(InputAction, false, FSimpleDelegate::CreateUObject(this, &ThisClass::HandleEscapeAction)));
+			EscapeMenuInputActionLoadRequest = FUIAsyncLoadRegistry::Get().RequestAsyncLoad(
+				EscapeMenuInputAction.ToSoftObjectPath(),
+				FStreamableDelegate::CreateUObject(this, &ThisClass::HandleEscapeMenuInputActionLoaded)
+			);
 		}
 	}
 	else
@@ -42,6 +49,16 @@ void UHUDLayout::NativeOnInitialized()
 	}
 }
 
+void UHUDLayout::HandleEscapeMenuInputActionLoaded()
+{
+	EscapeMenuInputActionLoadRequest.Reset();
+
+	if (auto* InputAction{ EscapeMenuInputAction.Get() })
+	{
+		RegisterUIActionBinding(FBindUIActionArgs(InputAction, false, FSimpleDelegate::CreateUObject(this, &ThisClass::HandleEscapeAction)));
+	}
+}
+
 void UHUDLayout::HandleEscapeAction()
 {
 	if (ensure(!EscapeMenuClass.IsNull()))
@@ -4,6 +4,8 @@
 
 #include "Foundation/ActivatableWidget.h"
 
+#include "Loading/UIAsyncLoadRegistry.h"
+
 #include "HUDLayout.generated.h"
 
 class UInputAction;
@@ -29,10 +31,14 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Game Menu")
 	TSoftObjectPtr<UInputAction> EscapeMenuInputAction;
 
+private:
+	TSharedPtr<FUIAsyncLoadRequest> EscapeMenuInputActionLoadRequest;
+
 public:
 	void NativeOnInitialized() override;
 
 protected:
+	void HandleEscapeMenuInputActionLoaded();
 	void HandleEscapeAction();
 
 };
@@ -0,0 +1,79 @@
+// Copyright (C) 2024 owoDra
+
+#include "HUDModelWidget.h"
+
+#include "HUD/UIHUDModel.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HUDModelWidget)
+
+
+UHUDModelWidget::UHUDModelWidget(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+
+void UHUDModelWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	// Changes were not received while destructed, so refresh everything
+
+	if (HUDModel.IsValid())
+	{
+		ListenModelChange();
+		OnHUDModelChanged(HUDModel.Get(), FGameplayTagContainer());
+	}
+}
+
+void UHUDModelWidget::NativeDestruct()
+{
+	UnlistenModelChange();
+
+	Super::NativeDestruct();
+}
+
+
+void UHUDModelWidget::SetHUDModel(UUIHUDModel* InHUDModel)
+{
+	if (HUDModel.Get() == InHUDModel)
+	{
+		return;
+	}
+
+	UnlistenModelChange();
+
+	HUDModel = InHUDModel;
+
+	if (InHUDModel)
+	{
+		ListenModelChange();
+		OnHUDModelChanged(InHUDModel, FGameplayTagContainer());
+	}
+}
+
+void UHUDModelWidget::ListenModelChange()
+{
+	if (auto* Model{ HUDModel.Get() })
+	{
+		if (!ModelChangedHandle.IsValid())
+		{
+			ModelChangedHandle = Model->OnModelChanged.AddUObject(this, &ThisClass::HandleModelChanged);
+		}
+	}
+}
+
+void UHUDModelWidget::UnlistenModelChange()
+{
+	if (auto* Model{ HUDModel.Get() })
+	{
+		Model->OnModelChanged.Remove(ModelChangedHandle);
+	}
+
+	ModelChangedHandle.Reset();
+}
+
+void UHUDModelWidget::HandleModelChanged(UUIHUDModel* Model, const FGameplayTagContainer& ChangedTags)
+{
+	OnHUDModelChanged(Model, ChangedTags);
+}
@@ -0,0 +1,68 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Blueprint/UserWidget.h"
+
+#include "GameplayTagContainer.h"
+
+#include "HUDModelWidget.generated.h"
+
+class UUIHUDModel;
+
+
+/**
+ * Widget that displays the values of a shared HUD model
+ * 
+ * Tips:
+ *	Place it in an extension point whose DataClasses contain UUIHUDModel, return GetWidgetClass() of the model from GetWidgetClassForData and call SetHUDModel from ConfigureWidgetForData.
+ *	The widget is only notified of the tags that changed, the values themselves are computed once for every local player.
+ */
+UCLASS(Abstract, Blueprintable)
+class GUIEXT_API UHUDModelWidget : public UUserWidget
+{
+	GENERATED_BODY()
+public:
+	UHUDModelWidget(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+protected:
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
+
+
+protected:
+	//
+	// Model displayed by this widget
+	//
+	UPROPERTY(Transient)
+	TWeakObjectPtr<UUIHUDModel> HUDModel{ nullptr };
+
+	FDelegateHandle ModelChangedHandle;
+
+public:
+	/**
+	 * Sets the model to display and refreshes every value
+	 */
+	UFUNCTION(BlueprintCallable, Category = "HUD Model")
+	void SetHUDModel(UUIHUDModel* InHUDModel);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HUD Model")
+	UUIHUDModel* GetHUDModel() const { return HUDModel.Get(); }
+
+protected:
+	void ListenModelChange();
+	void UnlistenModelChange();
+
+	void HandleModelChanged(UUIHUDModel* Model, const FGameplayTagContainer& ChangedTags);
+
+	/**
+	 * Notifies that values of the model have changed
+	 * 
+	 * Tips:
+	 *	ChangedTags is empty when the whole model should be refreshed (e.g. the model was set or the widget was constructed again)
+	 */
+	UFUNCTION(BlueprintNativeEvent, Category = "HUD Model")
+	void OnHUDModelChanged(UUIHUDModel* Model, const FGameplayTagContainer& ChangedTags);
+	virtual void OnHUDModelChanged_Implementation(UUIHUDModel* Model, const FGameplayTagContainer& ChangedTags) {}
+
+};
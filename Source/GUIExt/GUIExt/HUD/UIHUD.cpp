@@ -0,0 +1,71 @@
+// Copyright (C) 2024 owoDra
+
+#include "UIHUD.h"
+
+#include "UIManagerSubsystem.h"
+
+#include "Engine/GameInstance.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UIHUD)
+
+
+AUIHUD::AUIHUD(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bTickEvenWhenPaused = true;
+}
+
+
+void AUIHUD::BeginPlay()
+{
+	Super::BeginPlay();
+
+	NotifyShowHUDChanged();
+}
+
+void AUIHUD::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	NotifyShowHUDChanged();
+}
+
+
+void AUIHUD::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (bShowHUD != bLastNotifiedShowHUD)
+	{
+		NotifyShowHUDChanged();
+	}
+}
+
+
+void AUIHUD::ShowHUD()
+{
+	Super::ShowHUD();
+
+	NotifyShowHUDChanged();
+}
+
+void AUIHUD::SetShowHUD(bool bNewShowHUD)
+{
+	if (bShowHUD != bNewShowHUD)
+	{
+		bShowHUD = bNewShowHUD;
+
+		NotifyShowHUDChanged();
+	}
+}
+
+void AUIHUD::NotifyShowHUDChanged()
+{
+	bLastNotifiedShowHUD = bShowHUD;
+
+	if (auto* UIManager{ UGameInstance::GetSubsystem<UUIManagerSubsystem>(GetGameInstance()) })
+	{
+		UIManager->RequestRootLayoutVisibilitySync();
+	}
+}
@@ -0,0 +1,48 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "GameFramework/HUD.h"
+
+#include "UIHUD.generated.h"
+
+
+/**
+ * HUD that notifies the UI manager when it starts, ends or is toggled, so the root layouts are synced without polling every HUD
+ * 
+ * Tips:
+ *	Writing bShowHUD directly (e.g. cinematic mode or Blueprint) is fine, the HUD notices the change on its next tick.
+ */
+UCLASS()
+class GUIEXT_API AUIHUD : public AHUD
+{
+	GENERATED_BODY()
+public:
+	AUIHUD(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	virtual void Tick(float DeltaSeconds) override;
+
+protected:
+	//
+	// Value of bShowHUD last notified to the UI manager, to catch writes that bypass ShowHUD() and SetShowHUD()
+	//
+	bool bLastNotifiedShowHUD{ true };
+
+public:
+	virtual void ShowHUD() override;
+
+	/**
+	 * Shows or hides the HUD and the root layout of the owning player
+	 */
+	UFUNCTION(BlueprintCallable, Category = "HUD")
+	void SetShowHUD(bool bNewShowHUD);
+
+protected:
+	void NotifyShowHUDChanged();
+
+};
@@ -0,0 +1,119 @@
+// Copyright (C) 2024 owoDra
+
+#include "UIHUDModel.h"
+
+#include "Engine/World.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UIHUDModel)
+
+
+///////////////////////////////////////////////////////////
+// UUIHUDModel
+
+void UUIHUDModel::SetFloatValue(FGameplayTag Tag, float Value)
+{
+	auto* Current{ FloatValues.Find(Tag) };
+
+	if (!Current || (*Current != Value))
+	{
+		FloatValues.Add(Tag, Value);
+		MarkDirty(Tag);
+	}
+}
+
+void UUIHUDModel::SetIntValue(FGameplayTag Tag, int32 Value)
+{
+	auto* Current{ IntValues.Find(Tag) };
+
+	if (!Current || (*Current != Value))
+	{
+		IntValues.Add(Tag, Value);
+		MarkDirty(Tag);
+	}
+}
+
+void UUIHUDModel::SetTextValue(FGameplayTag Tag, FText Value)
+{
+	auto* Current{ TextValues.Find(Tag) };
+
+	if (!Current || !Current->EqualTo(Value))
+	{
+		TextValues.Add(Tag, MoveTemp(Value));
+		MarkDirty(Tag);
+	}
+}
+
+float UUIHUDModel::GetFloatValue(FGameplayTag Tag, float DefaultValue) const
+{
+	const auto* Value{ FloatValues.Find(Tag) };
+
+	return Value ? *Value : DefaultValue;
+}
+
+int32 UUIHUDModel::GetIntValue(FGameplayTag Tag, int32 DefaultValue) const
+{
+	const auto* Value{ IntValues.Find(Tag) };
+
+	return Value ? *Value : DefaultValue;
+}
+
+FText UUIHUDModel::GetTextValue(FGameplayTag Tag) const
+{
+	const auto* Value{ TextValues.Find(Tag) };
+
+	return Value ? *Value : FText::GetEmpty();
+}
+
+bool UUIHUDModel::HasValue(FGameplayTag Tag) const
+{
+	return FloatValues.Contains(Tag) || IntValues.Contains(Tag) || TextValues.Contains(Tag);
+}
+
+
+void UUIHUDModel::Flush()
+{
+	if (DirtyTags.IsEmpty())
+	{
+		return;
+	}
+
+	// Reset before broadcasting so that values set by subscribers are sent on the next flush
+
+	auto ChangedTags{ MoveTemp(DirtyTags) };
+	DirtyTags.Reset();
+
+	NumFlushes++;
+
+	OnModelChanged.Broadcast(this, ChangedTags);
+	OnModelChangedDynamic.Broadcast(this, ChangedTags);
+}
+
+void UUIHUDModel::MarkDirty(const FGameplayTag& Tag)
+{
+	DirtyTags.AddTag(Tag);
+}
+
+
+///////////////////////////////////////////////////////////
+// UUIHUDModelSource
+
+UWorld* UUIHUDModelSource::GetWorld() const
+{
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return nullptr;
+	}
+
+	return GetOuter() ? GetOuter()->GetWorld() : nullptr;
+}
+
+
+void UUIHUDModelSource::NativeInitializeModel(UUIHUDModel* Model)
+{
+	K2_InitializeModel(Model);
+}
+
+void UUIHUDModelSource::NativeUpdateModel(UUIHUDModel* Model, float DeltaTime)
+{
+	K2_UpdateModel(Model, DeltaTime);
+}
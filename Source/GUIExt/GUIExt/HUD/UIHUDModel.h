@@ -0,0 +1,143 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "UObject/Object.h"
+
+#include "GameplayTagContainer.h"
+
+#include "UIHUDModel.generated.h"
+
+class UUIHUDModel;
+class UUserWidget;
+
+
+/**
+ * Delegate to notify the values that changed in the HUD model during the last frame
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FUIHUDModelChangedDelegate, UUIHUDModel*, const FGameplayTagContainer&);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FUIHUDModelChangedDynamicDelegate, UUIHUDModel*, Model, const FGameplayTagContainer&, ChangedTags);
+
+
+/**
+ * Match-wide HUD values (e.g. timer, scores, objective state) computed once and shared by every local player
+ *
+ * Tips:
+ *	Values are keyed by tag and only a value that actually changed is marked dirty.
+ *	Changes are collected during the frame and broadcast once by Flush(), so subscribers only see the changed tags.
+ */
+UCLASS(BlueprintType)
+class GUIEXT_API UUIHUDModel : public UObject
+{
+	GENERATED_BODY()
+public:
+	UUIHUDModel() {}
+
+protected:
+	UPROPERTY(Transient)
+	TMap<FGameplayTag, float> FloatValues;
+
+	UPROPERTY(Transient)
+	TMap<FGameplayTag, int32> IntValues;
+
+	UPROPERTY(Transient)
+	TMap<FGameplayTag, FText> TextValues;
+
+	//
+	// Tags whose value changed since the last flush
+	//
+	FGameplayTagContainer DirtyTags;
+
+	//
+	// Widget class to display this model in the extension points
+	//
+	UPROPERTY(Transient)
+	TSubclassOf<UUserWidget> WidgetClass;
+
+	int32 NumFlushes{ 0 };
+
+public:
+	FUIHUDModelChangedDelegate OnModelChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "HUD Model")
+	FUIHUDModelChangedDynamicDelegate OnModelChangedDynamic;
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "HUD Model")
+	void SetFloatValue(FGameplayTag Tag, float Value);
+
+	UFUNCTION(BlueprintCallable, Category = "HUD Model")
+	void SetIntValue(FGameplayTag Tag, int32 Value);
+
+	UFUNCTION(BlueprintCallable, Category = "HUD Model")
+	void SetTextValue(FGameplayTag Tag, FText Value);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HUD Model")
+	float GetFloatValue(FGameplayTag Tag, float DefaultValue = 0.0f) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HUD Model")
+	int32 GetIntValue(FGameplayTag Tag, int32 DefaultValue = 0) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HUD Model")
+	FText GetTextValue(FGameplayTag Tag) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HUD Model")
+	bool HasValue(FGameplayTag Tag) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HUD Model")
+	TSubclassOf<UUserWidget> GetWidgetClass() const { return WidgetClass; }
+
+	void SetWidgetClass(TSubclassOf<UUserWidget> InWidgetClass) { WidgetClass = InWidgetClass; }
+
+	bool IsDirty() const { return !DirtyTags.IsEmpty(); }
+
+	int32 GetNumFlushes() const { return NumFlushes; }
+
+	/**
+	 * Broadcasts the tags that changed since the last flush to every subscriber.
+	 *
+	 * Tips:
+	 *	Called once per frame by UUIHUDModelSubsystem, does nothing if no value changed.
+	 */
+	void Flush();
+
+protected:
+	void MarkDirty(const FGameplayTag& Tag);
+
+};
+
+
+/**
+ * Computes the values of a HUD model from the game state
+ *
+ * Tips:
+ *	A single instance exists per world and is updated once per frame regardless of the number of local players.
+ */
+UCLASS(Abstract, Blueprintable, EditInlineNew)
+class GUIEXT_API UUIHUDModelSource : public UObject
+{
+	GENERATED_BODY()
+public:
+	UUIHUDModelSource() {}
+
+	virtual UWorld* GetWorld() const override;
+
+public:
+	/**
+	 * Called after the source is registered, before the first update
+	 */
+	virtual void NativeInitializeModel(UUIHUDModel* Model);
+
+	/**
+	 * Writes the current values to the model, unchanged values are not broadcast
+	 */
+	virtual void NativeUpdateModel(UUIHUDModel* Model, float DeltaTime);
+
+protected:
+	UFUNCTION(BlueprintImplementableEvent, Category = "HUD Model", meta = (DisplayName = "InitializeModel"))
+	void K2_InitializeModel(UUIHUDModel* Model);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "HUD Model", meta = (DisplayName = "UpdateModel"))
+	void K2_UpdateModel(UUIHUDModel* Model, float DeltaTime);
+
+};
@@ -0,0 +1,160 @@
+// Copyright (C) 2024 owoDra
+
+#include "UIHUDModelSubsystem.h"
+
+#include "HUD/UIHUDModel.h"
+#include "Extension/UIExtensionPointSubsystem.h"
+#include "GUIExtLogs.h"
+
+#include "Engine/World.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UIHUDModelSubsystem)
+
+
+bool UUIHUDModelSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UUIHUDModelSubsystem::Deinitialize()
+{
+	for (auto& Registration : RegisteredModels)
+	{
+		Registration.ExtensionHandle.Unregister();
+	}
+
+	RegisteredModels.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UUIHUDModelSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return (WorldType == EWorldType::Game) || (WorldType == EWorldType::PIE);
+}
+
+
+void UUIHUDModelSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Sources and subscribers may register or unregister models, so iterate over a copy
+
+	TArray<TPair<TObjectPtr<UUIHUDModel>, TObjectPtr<UUIHUDModelSource>>, TInlineAllocator<8>> Registrations;
+
+	for (const auto& Registration : RegisteredModels)
+	{
+		Registrations.Emplace(Registration.Model, Registration.Source);
+	}
+
+	// Every source is updated first so that the models are flushed with the values of the same frame
+
+	for (const auto& KVP : Registrations)
+	{
+		if (KVP.Key && KVP.Value)
+		{
+			KVP.Value->NativeUpdateModel(KVP.Key, DeltaTime);
+		}
+	}
+
+	for (const auto& KVP : Registrations)
+	{
+		if (KVP.Key)
+		{
+			KVP.Key->Flush();
+		}
+	}
+}
+
+TStatId UUIHUDModelSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UUIHUDModelSubsystem, STATGROUP_Tickables);
+}
+
+bool UUIHUDModelSubsystem::IsTickable() const
+{
+	return !RegisteredModels.IsEmpty() && Super::IsTickable();
+}
+
+
+UUIHUDModel* UUIHUDModelSubsystem::RegisterModelSource(FGameplayTag ExtensionPointTag, TSubclassOf<UUIHUDModelSource> SourceClass, TSubclassOf<UUserWidget> WidgetClass, int32 Priority)
+{
+	if (!ExtensionPointTag.IsValid() || !SourceClass)
+	{
+		return nullptr;
+	}
+
+	for (auto& Registration : RegisteredModels)
+	{
+		if ((Registration.ExtensionPointTag == ExtensionPointTag) && (Registration.Source->GetClass() == SourceClass))
+		{
+			Registration.NumRegistrations++;
+			return Registration.Model;
+		}
+	}
+
+	auto* Source{ NewObject<UUIHUDModelSource>(this, SourceClass) };
+	auto* Model{ NewObject<UUIHUDModel>(this) };
+	Model->SetWidgetClass(WidgetClass);
+
+	// Compute the first values before publishing, so the widgets are created with a complete model.
+	// These are Blueprint calls that may register other models, so the registration is only added afterwards.
+
+	Source->NativeInitializeModel(Model);
+	Source->NativeUpdateModel(Model, 0.0f);
+	Model->Flush();
+
+	auto& Registration{ RegisteredModels.AddDefaulted_GetRef() };
+	Registration.ExtensionPointTag = ExtensionPointTag;
+	Registration.NumRegistrations = 1;
+	Registration.Source = Source;
+	Registration.Model = Model;
+
+	// Without context, so the extension points of every local player receive the same model
+
+	if (auto* ExtensionSubsystem{ GetWorld()->GetSubsystem<UUIExtensionPointSubsystem>() })
+	{
+		auto ExtensionHandle{ ExtensionSubsystem->RegisterExtensionAsData(ExtensionPointTag, nullptr, Model, Priority) };
+
+		// The registration array may have grown while the extension points created their widgets
+
+		if (auto* Found{ RegisteredModels.FindByPredicate([Model](const FUIHUDModelRegistration& Other) { return Other.Model == Model; }) })
+		{
+			Found->ExtensionHandle = ExtensionHandle;
+		}
+	}
+
+	UE_LOG(LogGameExt_UI, Log, TEXT("Registered HUD model [%s] on [%s]"), *GetNameSafe(SourceClass), *ExtensionPointTag.ToString());
+
+	return Model;
+}
+
+void UUIHUDModelSubsystem::UnregisterModelSource(UUIHUDModel* Model)
+{
+	const auto Index{ RegisteredModels.IndexOfByPredicate([Model](const FUIHUDModelRegistration& Registration) { return Registration.Model == Model; }) };
+
+	if (!RegisteredModels.IsValidIndex(Index) || (--RegisteredModels[Index].NumRegistrations > 0))
+	{
+		return;
+	}
+
+	auto Registration{ RegisteredModels[Index] };
+	RegisteredModels.RemoveAt(Index);
+
+	Registration.ExtensionHandle.Unregister();
+
+	UE_LOG(LogGameExt_UI, Log, TEXT("Unregistered HUD model [%s] on [%s]"), *GetNameSafe(Registration.Source), *Registration.ExtensionPointTag.ToString());
+}
+
+UUIHUDModel* UUIHUDModelSubsystem::FindModel(FGameplayTag ExtensionPointTag, TSubclassOf<UUIHUDModelSource> SourceClass) const
+{
+	for (const auto& Registration : RegisteredModels)
+	{
+		if ((Registration.ExtensionPointTag == ExtensionPointTag) && (Registration.Source->GetClass() == SourceClass))
+		{
+			return Registration.Model;
+		}
+	}
+
+	return nullptr;
+}
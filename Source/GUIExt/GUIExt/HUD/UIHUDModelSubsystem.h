@@ -0,0 +1,99 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+
+#include "Extension/UIExtensionPointTypes.h"
+
+#include "GameplayTagContainer.h"
+
+#include "UIHUDModelSubsystem.generated.h"
+
+class UUIHUDModel;
+class UUIHUDModelSource;
+class UUserWidget;
+
+
+/**
+ * Model registered in UUIHUDModelSubsystem together with the source that computes it
+ */
+USTRUCT()
+struct FUIHUDModelRegistration
+{
+	GENERATED_BODY()
+public:
+	FUIHUDModelRegistration() {}
+
+public:
+	UPROPERTY()
+	TObjectPtr<UUIHUDModel> Model{ nullptr };
+
+	UPROPERTY()
+	TObjectPtr<UUIHUDModelSource> Source{ nullptr };
+
+	UPROPERTY()
+	FGameplayTag ExtensionPointTag;
+
+	UPROPERTY()
+	FUIExtensionHandle ExtensionHandle;
+
+	//
+	// Number of registrations sharing this model
+	//
+	int32 NumRegistrations{ 0 };
+
+};
+
+
+/**
+ * Subsystem that updates the shared HUD models once per frame and publishes them to the extension points of every local player
+ *
+ * Tips:
+ *	Each model is registered as a data extension without context, so every player's extension point that accepts UUIHUDModel receives it.
+ *	N local players cost one source update plus N widget updates for the tags that changed.
+ */
+UCLASS()
+class GUIEXT_API UUIHUDModelSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	UUIHUDModelSubsystem() {}
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY(Transient)
+	TArray<FUIHUDModelRegistration> RegisteredModels;
+
+public:
+	/**
+	 * Creates the model computed by the source class and publishes it to the extension point, or returns the existing one.
+	 *
+	 * Tips:
+	 *	Registering the same source class on the same extension point again shares the model, each call must be balanced by UnregisterModelSource.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "HUD Model")
+	UUIHUDModel* RegisterModelSource(
+		UPARAM(meta = (Categories = "UI.Extension")) FGameplayTag ExtensionPointTag
+		, TSubclassOf<UUIHUDModelSource> SourceClass
+		, TSubclassOf<UUserWidget> WidgetClass
+		, int32 Priority = -1);
+
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "HUD Model")
+	void UnregisterModelSource(UUIHUDModel* Model);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "HUD Model")
+	UUIHUDModel* FindModel(FGameplayTag ExtensionPointTag, TSubclassOf<UUIHUDModelSource> SourceClass) const;
+
+	int32 GetNumModels() const { return RegisteredModels.Num(); }
+
+};
@@ -0,0 +1,114 @@
+// Copyright (C) 2024 owoDra
+
+#include "UIHeadlessLayout.h"
+
+#include "GUIExtLogs.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UIHeadlessLayout)
+
+
+void FUIHeadlessLayout::Push(FGameplayTag LayerTag, const FSoftObjectPath& WidgetClass)
+{
+	auto& Entry{ Layers.FindOrAdd(LayerTag).AddDefaulted_GetRef() };
+	Entry.WidgetClass = WidgetClass;
+	Entry.PushTime = FPlatformTime::Seconds();
+
+	Stats.NumPushes++;
+
+	UE_LOG(LogGameExt_UI, VeryVerbose, TEXT("Headless push [%s] to [%s]"), *WidgetClass.ToString(), *LayerTag.ToString());
+}
+
+bool FUIHeadlessLayout::Pop(FGameplayTag LayerTag)
+{
+	auto* Stack{ Layers.Find(LayerTag) };
+
+	if (!Stack || Stack->IsEmpty())
+	{
+		return false;
+	}
+
+	Stack->Pop();
+	Stats.NumPops++;
+
+	return true;
+}
+
+bool FUIHeadlessLayout::Remove(FGameplayTag LayerTag, const FSoftObjectPath& WidgetClass)
+{
+	auto* Stack{ Layers.Find(LayerTag) };
+
+	if (!Stack)
+	{
+		return false;
+	}
+
+	const auto Index{ Stack->FindLastByPredicate([&WidgetClass](const FLayerEntry& Entry) { return Entry.WidgetClass == WidgetClass; }) };
+
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	Stack->RemoveAt(Index);
+	Stats.NumPops++;
+
+	return true;
+}
+
+void FUIHeadlessLayout::ClearLayer(FGameplayTag LayerTag)
+{
+	if (auto* Stack{ Layers.Find(LayerTag) })
+	{
+		Stats.NumPops += Stack->Num();
+		Stack->Reset();
+	}
+}
+
+void FUIHeadlessLayout::ClearAll()
+{
+	for (auto& KVP : Layers)
+	{
+		Stats.NumPops += KVP.Value.Num();
+		KVP.Value.Reset();
+	}
+}
+
+void FUIHeadlessLayout::CullLayersForTravel(const FGameplayTagContainer& PersistentLayers)
+{
+	for (auto& KVP : Layers)
+	{
+		if (!PersistentLayers.HasTagExact(KVP.Key))
+		{
+			Stats.NumPops += KVP.Value.Num();
+			KVP.Value.Reset();
+		}
+	}
+}
+
+
+int32 FUIHeadlessLayout::GetLayerDepth(FGameplayTag LayerTag) const
+{
+	const auto* Stack{ Layers.Find(LayerTag) };
+
+	return Stack ? Stack->Num() : 0;
+}
+
+FSoftObjectPath FUIHeadlessLayout::GetTopWidgetClass(FGameplayTag LayerTag) const
+{
+	const auto* Stack{ Layers.Find(LayerTag) };
+
+	return (Stack && !Stack->IsEmpty()) ? Stack->Last().WidgetClass : FSoftObjectPath();
+}
+
+FUIHeadlessLayoutStats FUIHeadlessLayout::GetStats() const
+{
+	auto Result{ Stats };
+	Result.NumEntries = 0;
+
+	for (const auto& KVP : Layers)
+	{
+		Result.NumEntries += KVP.Value.Num();
+	}
+
+	return Result;
+}
@@ -0,0 +1,100 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "UObject/SoftObjectPath.h"
+
+#include "UIHeadlessLayout.generated.h"
+
+
+/**
+ * How the headless layout of a player has been used
+ */
+USTRUCT(BlueprintType)
+struct FUIHeadlessLayoutStats
+{
+	GENERATED_BODY()
+public:
+	FUIHeadlessLayoutStats() {}
+
+public:
+	//
+	// Number of widget classes pushed to the layers
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 NumPushes{ 0 };
+
+	//
+	// Number of entries removed from the layers, including the ones culled by travel
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 NumPops{ 0 };
+
+	//
+	// Number of entries currently on the layers
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 NumEntries{ 0 };
+
+};
+
+
+/**
+ * Logical stand-in for the root layout of a player when the UI runs headless
+ *
+ * Tips:
+ *	Pushes only record the widget class on a per-layer stack, no widget class is loaded and no UUserWidget or Slate object is created.
+ *	It follows the same travel rules as UUILayout so that bots go through the same layer transitions as players.
+ */
+class GUIEXT_API FUIHeadlessLayout
+{
+public:
+	FUIHeadlessLayout() {}
+
+private:
+	struct FLayerEntry
+	{
+		FSoftObjectPath WidgetClass;
+		double PushTime{ 0.0 };
+	};
+
+	TMap<FGameplayTag, TArray<FLayerEntry>> Layers;
+
+	//
+	// Whether the content survives the next world change, see UUILayout::SetPersistAcrossWorldChange
+	//
+	bool bPersistAcrossWorldChange{ false };
+
+	FUIHeadlessLayoutStats Stats;
+
+public:
+	void Push(FGameplayTag LayerTag, const FSoftObjectPath& WidgetClass);
+
+	/**
+	 * Removes the top entry of the layer, returns false if the layer is empty
+	 */
+	bool Pop(FGameplayTag LayerTag);
+
+	/**
+	 * Removes the topmost entry of the widget class from the layer
+	 */
+	bool Remove(FGameplayTag LayerTag, const FSoftObjectPath& WidgetClass);
+
+	void ClearLayer(FGameplayTag LayerTag);
+	void ClearAll();
+
+	/**
+	 * Clears every layer that is not in PersistentLayers, see UUILayout::CullLayersForTravel
+	 */
+	void CullLayersForTravel(const FGameplayTagContainer& PersistentLayers);
+
+	int32 GetLayerDepth(FGameplayTag LayerTag) const;
+	FSoftObjectPath GetTopWidgetClass(FGameplayTag LayerTag) const;
+
+	void SetPersistAcrossWorldChange(bool bPersist) { bPersistAcrossWorldChange = bPersist; }
+	bool PersistsAcrossWorldChange() const { return bPersistAcrossWorldChange; }
+
+	FUIHeadlessLayoutStats GetStats() const;
+
+};
@@ -0,0 +1,175 @@
+// Copyright (C) 2024 owoDra
+
+#include "UIInputConfigSubsystem.h"
+
+#include "Foundation/ActivatableWidget.h"
+#include "UILayout.h"
+#include "UIDeveloperSettings.h"
+#include "GUIExtLogs.h"
+
+#include "Engine/LocalPlayer.h"
+#include "Input/CommonUIActionRouterBase.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UIInputConfigSubsystem)
+
+
+void UUIInputConfigSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(ResolveTickerHandle);
+	ResolveTickerHandle.Reset();
+
+	ActiveWidgets.Reset();
+
+	LastAppliedConfig.Reset();
+	LastAppliedOwner.Reset();
+
+	Super::Deinitialize();
+}
+
+
+void UUIInputConfigSubsystem::RegisterActiveWidget(UActivatableWidget* Widget)
+{
+	if (Widget)
+	{
+		ActiveWidgets.Remove(Widget);
+		ActiveWidgets.Add(Widget);
+
+		RequestResolve();
+	}
+}
+
+void UUIInputConfigSubsystem::UnregisterActiveWidget(UActivatableWidget* Widget)
+{
+	if (ActiveWidgets.Remove(Widget) > 0)
+	{
+		RequestResolve();
+	}
+}
+
+void UUIInputConfigSubsystem::RequestResolve()
+{
+	if (!ResolveTickerHandle.IsValid())
+	{
+		ResolveTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::HandleResolveTick), 0.0f);
+	}
+}
+
+
+bool UUIInputConfigSubsystem::HandleResolveTick(float DeltaTime)
+{
+	ResolveTickerHandle.Reset();
+
+	ResolveInputConfig();
+
+	// One-shot, the next change requests a new resolve
+
+	return false;
+}
+
+void UUIInputConfigSubsystem::ResolveInputConfig()
+{
+	ActiveWidgets.RemoveAll([](const TWeakObjectPtr<UActivatableWidget>& Widget) { return !Widget.IsValid(); });
+
+	NumResolves++;
+
+	auto* ActionRouter{ GetLocalPlayer()->GetSubsystem<UCommonUIActionRouterBase>() };
+
+	if (!ActionRouter)
+	{
+		return;
+	}
+
+	TOptional<FUIInputConfig> WinningConfig;
+	auto* WinningWidget{ FindWinningWidget(WinningConfig) };
+
+	const auto IsActiveOnRouter
+	{
+		[ActionRouter](const FUIInputConfig& InConfig)
+		{
+			return (ActionRouter->GetActiveInputMode() == InConfig.GetInputMode()) && (ActionRouter->GetActiveMouseCaptureMode() == InConfig.GetMouseCaptureMode());
+		}
+	};
+
+	// Other widgets and game code also write to the action router, so only fall back from a config that we applied ourselves
+
+	if (!WinningWidget || !WinningConfig.IsSet())
+	{
+		if (!LastAppliedConfig.IsSet() || !IsActiveOnRouter(LastAppliedConfig.GetValue()))
+		{
+			UE_LOG(LogGameExt_UI, VeryVerbose, TEXT("Input config on the router was not applied by this subsystem, fallback skipped"));
+
+			LastAppliedConfig.Reset();
+			LastAppliedOwner.Reset();
+			return;
+		}
+
+		UE_LOG(LogGameExt_UI, VeryVerbose, TEXT("Falling back from the input config of [%s]"), *GetNameSafe(LastAppliedOwner.Get()));
+
+		WinningWidget = nullptr;
+		WinningConfig = GetFallbackInputConfig();
+	}
+
+	const auto& Config{ WinningConfig.GetValue() };
+
+	LastAppliedConfig = Config;
+	LastAppliedOwner = WinningWidget;
+
+	// Compare with the router itself rather than what we applied last, it may have been changed behind our back
+
+	if (IsActiveOnRouter(Config))
+	{
+		UE_LOG(LogGameExt_UI, VeryVerbose, TEXT("Input config of [%s] already active, skipped"), *GetNameSafe(WinningWidget));
+		return;
+	}
+
+	NumApplies++;
+
+	UE_LOG(LogGameExt_UI, Verbose, TEXT("Applied input config of [%s] (Applies: %d, Resolves: %d)"), WinningWidget ? *GetNameSafe(WinningWidget) : TEXT("Fallback"), NumApplies, NumResolves);
+
+	ActionRouter->SetActiveUIInputConfig(Config, WinningWidget);
+}
+
+FUIInputConfig UUIInputConfigSubsystem::GetFallbackInputConfig() const
+{
+	const auto* DevSettings{ GetDefault<UUIDeveloperSettings>() };
+
+	return FUIInputConfig(DevSettings->FallbackInputMode, DevSettings->FallbackMouseCaptureMode);
+}
+
+UActivatableWidget* UUIInputConfigSubsystem::FindWinningWidget(TOptional<FUIInputConfig>& OutConfig) const
+{
+	const auto* RootLayout{ UUILayout::GetUILayout(GetLocalPlayer()) };
+
+	UActivatableWidget* WinningWidget{ nullptr };
+	auto WinningDrawOrder{ TNumericLimits<int32>::Lowest() };
+
+	// Later activations win ties, so walk in activation order and accept equal draw orders
+
+	for (const auto& WeakWidget : ActiveWidgets)
+	{
+		auto* Widget{ WeakWidget.Get() };
+		auto Config{ Widget ? Widget->ResolveDesiredInputConfig() : TOptional<FUIInputConfig>() };
+
+		if (!Config.IsSet())
+		{
+			continue;
+		}
+
+		const auto DrawOrder{ RootLayout ? RootLayout->GetLayerDrawOrder(RootLayout->GetLayerForWidget(Widget)) : INDEX_NONE };
+
+		if (DrawOrder >= WinningDrawOrder)
+		{
+			WinningWidget = Widget;
+			WinningDrawOrder = DrawOrder;
+			OutConfig = MoveTemp(Config);
+		}
+	}
+
+	return WinningWidget;
+}
+
+
+UUIInputConfigSubsystem* UUIInputConfigSubsystem::Get(const ULocalPlayer* LocalPlayer)
+{
+	return LocalPlayer ? LocalPlayer->GetSubsystem<UUIInputConfigSubsystem>() : nullptr;
+}
@@ -0,0 +1,85 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Subsystems/LocalPlayerSubsystem.h"
+
+#include "CommonUITypes.h"
+#include "Containers/Ticker.h"
+
+#include "UIInputConfigSubsystem.generated.h"
+
+class UActivatableWidget;
+
+
+/**
+ * Per-player service that arbitrates the input configs of the active widgets.
+ * The winner is resolved at most once per frame and the action router is only touched when its active config differs.
+ *
+ * Tips:
+ *	The widget on the highest layer wins, widgets on the same layer are ordered by activation.
+ *	Widgets that are not on a layer of the root layout rank below every layer.
+ *	While no active widget wants a config, the fallback config of UUIDeveloperSettings is applied,
+ *	but only if the config active on the action router is still the one this subsystem applied.
+ */
+UCLASS()
+class GUIEXT_API UUIInputConfigSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+public:
+	UUIInputConfigSubsystem() {}
+
+public:
+	virtual void Deinitialize() override;
+
+private:
+	//
+	// Active widgets in activation order
+	//
+	TArray<TWeakObjectPtr<UActivatableWidget>> ActiveWidgets;
+
+	FTSTicker::FDelegateHandle ResolveTickerHandle;
+
+	//
+	// Config this subsystem applied last and the widget it was applied for, unset once something else replaced it
+	//
+	TOptional<FUIInputConfig> LastAppliedConfig;
+	TWeakObjectPtr<UActivatableWidget> LastAppliedOwner;
+
+	int32 NumResolves{ 0 };
+	int32 NumApplies{ 0 };
+
+public:
+	void RegisterActiveWidget(UActivatableWidget* Widget);
+	void UnregisterActiveWidget(UActivatableWidget* Widget);
+
+	/**
+	 * Schedules the config to be resolved on the next tick, several requests in the same frame resolve only once
+	 */
+	void RequestResolve();
+
+	int32 GetNumResolves() const { return NumResolves; }
+	int32 GetNumApplies() const { return NumApplies; }
+
+protected:
+	bool HandleResolveTick(float DeltaTime);
+
+	/**
+	 * Resolves the winning widget and applies its config if it differs from the one active on the action router
+	 */
+	void ResolveInputConfig();
+
+	/**
+	 * Returns the config applied while no active widget wants one
+	 */
+	virtual FUIInputConfig GetFallbackInputConfig() const;
+
+	/**
+	 * Returns the widget whose input config should be applied, or nullptr if no active widget has one
+	 */
+	virtual UActivatableWidget* FindWinningWidget(TOptional<FUIInputConfig>& OutConfig) const;
+
+public:
+	static UUIInputConfigSubsystem* Get(const ULocalPlayer* LocalPlayer);
+
+};
@@ -0,0 +1,172 @@
+// Copyright (C) 2024 owoDra
+
+#include "UIInputSuspensionSubsystem.h"
+
+#include "GUIExtLogs.h"
+
+#include "CommonInputSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UIInputSuspensionSubsystem)
+
+
+///////////////////////////////////////////////////////////
+// FUIInputSuspensionHandle
+
+FUIInputSuspensionHandle::FUIInputSuspensionHandle(UUIInputSuspensionSubsystem* InSubsystem, FName InToken)
+	: Subsystem(InSubsystem)
+	, Token(InToken)
+{
+}
+
+FUIInputSuspensionHandle::~FUIInputSuspensionHandle()
+{
+	Reset();
+}
+
+FUIInputSuspensionHandle::FUIInputSuspensionHandle(FUIInputSuspensionHandle&& Other)
+	: Subsystem(MoveTemp(Other.Subsystem))
+	, Token(Other.Token)
+{
+	Other.Token = NAME_None;
+}
+
+FUIInputSuspensionHandle& FUIInputSuspensionHandle::operator=(FUIInputSuspensionHandle&& Other)
+{
+	if (this != &Other)
+	{
+		Reset();
+
+		Subsystem = MoveTemp(Other.Subsystem);
+		Token = Other.Token;
+		Other.Token = NAME_None;
+	}
+
+	return *this;
+}
+
+
+void FUIInputSuspensionHandle::Reset()
+{
+	if (auto* PinnedSubsystem{ Subsystem.Get() })
+	{
+		PinnedSubsystem->ResumeInput(Token);
+	}
+
+	Subsystem.Reset();
+	Token = NAME_None;
+}
+
+
+///////////////////////////////////////////////////////////
+// UUIInputSuspensionSubsystem
+
+void UUIInputSuspensionSubsystem::Deinitialize()
+{
+	ActiveSuspensions.Reset();
+
+	SetInputFiltered(false);
+
+	Super::Deinitialize();
+}
+
+
+FName UUIInputSuspensionSubsystem::SuspendInput(FName Reason)
+{
+	auto Token{ Reason };
+	Token.SetNumber(++LastSuspensionNumber);
+
+	auto& Suspension{ ActiveSuspensions.Add(Token) };
+	Suspension.Reason = Reason;
+	Suspension.StartTime = FPlatformTime::Seconds();
+
+	if (ActiveSuspensions.Num() == 1)
+	{
+		SetInputFiltered(true);
+	}
+
+	return Token;
+}
+
+FUIInputSuspensionHandle UUIInputSuspensionSubsystem::SuspendInputScoped(FName Reason)
+{
+	return FUIInputSuspensionHandle(this, SuspendInput(Reason));
+}
+
+void UUIInputSuspensionSubsystem::ResumeInput(FName Token)
+{
+	if ((Token == NAME_None) || (ActiveSuspensions.Remove(Token) == 0))
+	{
+		return;
+	}
+
+	if (ActiveSuspensions.IsEmpty())
+	{
+		SetInputFiltered(false);
+	}
+}
+
+void UUIInputSuspensionSubsystem::LogActiveSuspensions() const
+{
+	const auto* LocalPlayer{ GetLocalPlayer() };
+	const auto Now{ FPlatformTime::Seconds() };
+
+	UE_LOG(LogGameExt_UI, Log, TEXT("Input suspensions of player [%d]: %d"), LocalPlayer ? LocalPlayer->GetControllerId() : -1, ActiveSuspensions.Num());
+
+	for (const auto& KVP : ActiveSuspensions)
+	{
+		UE_LOG(LogGameExt_UI, Log, TEXT("  [%s] Reason: %s, Age: %.2fs"), *KVP.Key.ToString(), *KVP.Value.Reason.ToString(), Now - KVP.Value.StartTime);
+	}
+}
+
+
+void UUIInputSuspensionSubsystem::SetInputFiltered(bool bFiltered)
+{
+	if (bInputFiltered == bFiltered)
+	{
+		return;
+	}
+
+	bInputFiltered = bFiltered;
+
+	// A single filter reason is used for every suspension of this player
+
+	static const auto NAME_UIInputSuspension{ FName(TEXT("UIInputSuspension")) };
+
+	if (auto* CommonInputSubsystem{ UCommonInputSubsystem::Get(GetLocalPlayer()) })
+	{
+		CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::MouseAndKeyboard, NAME_UIInputSuspension, bFiltered);
+		CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::Gamepad, NAME_UIInputSuspension, bFiltered);
+		CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::Touch, NAME_UIInputSuspension, bFiltered);
+	}
+}
+
+
+UUIInputSuspensionSubsystem* UUIInputSuspensionSubsystem::Get(const ULocalPlayer* LocalPlayer)
+{
+	return LocalPlayer ? LocalPlayer->GetSubsystem<UUIInputSuspensionSubsystem>() : nullptr;
+}
+
+
+static FAutoConsoleCommandWithWorld ListInputSuspensionsCommand(
+	TEXT("GUIExt.ListInputSuspensions"),
+	TEXT("Lists the active UI input suspensions of every local player with their reasons and ages"),
+	FConsoleCommandWithWorldDelegate::CreateStatic(
+		[](UWorld* World)
+		{
+			if (const auto* GameInstance{ World ? World->GetGameInstance() : nullptr })
+			{
+				for (const auto* LocalPlayer : GameInstance->GetLocalPlayers())
+				{
+					if (const auto* Subsystem{ UUIInputSuspensionSubsystem::Get(LocalPlayer) })
+					{
+						Subsystem->LogActiveSuspensions();
+					}
+				}
+			}
+		}
+	)
+);
@@ -0,0 +1,108 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Subsystems/LocalPlayerSubsystem.h"
+
+#include "UIInputSuspensionSubsystem.generated.h"
+
+class UUIInputSuspensionSubsystem;
+
+
+/**
+ * Move-only handle that keeps the input of a player suspended until it is reset or destroyed
+ */
+struct GUIEXT_API FUIInputSuspensionHandle
+{
+public:
+	FUIInputSuspensionHandle() {}
+	FUIInputSuspensionHandle(UUIInputSuspensionSubsystem* InSubsystem, FName InToken);
+	~FUIInputSuspensionHandle();
+
+	FUIInputSuspensionHandle(FUIInputSuspensionHandle&& Other);
+	FUIInputSuspensionHandle& operator=(FUIInputSuspensionHandle&& Other);
+
+	FUIInputSuspensionHandle(const FUIInputSuspensionHandle&) = delete;
+	FUIInputSuspensionHandle& operator=(const FUIInputSuspensionHandle&) = delete;
+
+private:
+	TWeakObjectPtr<UUIInputSuspensionSubsystem> Subsystem;
+
+	FName Token{ NAME_None };
+
+public:
+	/**
+	 * Resumes the input suspended by this handle
+	 */
+	void Reset();
+
+	bool IsValid() const { return Token != NAME_None; }
+
+	FName GetToken() const { return Token; }
+
+};
+
+
+/**
+ * Per-player service that reference counts the reasons the UI suspends input.
+ * CommonInput is only touched when the first suspension starts and when the last one ends.
+ */
+UCLASS()
+class GUIEXT_API UUIInputSuspensionSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+public:
+	UUIInputSuspensionSubsystem() {}
+
+public:
+	virtual void Deinitialize() override;
+
+private:
+	struct FActiveSuspension
+	{
+		FName Reason;
+		double StartTime{ 0.0 };
+	};
+
+	//
+	// Active suspensions keyed by their token
+	//
+	TMap<FName, FActiveSuspension> ActiveSuspensions;
+
+	int32 LastSuspensionNumber{ 0 };
+
+	bool bInputFiltered{ false };
+
+public:
+	/**
+	 * Suspends the input of the player and returns the token needed to resume it
+	 */
+	FName SuspendInput(FName Reason);
+
+	/**
+	 * Suspends the input of the player until the returned handle is reset or destroyed
+	 */
+	FUIInputSuspensionHandle SuspendInputScoped(FName Reason);
+
+	/**
+	 * Releases the suspension of the token, the input resumes once no suspension is left
+	 */
+	void ResumeInput(FName Token);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Input")
+	bool IsInputSuspended() const { return !ActiveSuspensions.IsEmpty(); }
+
+	int32 GetNumSuspensions() const { return ActiveSuspensions.Num(); }
+
+	/**
+	 * Writes the active suspensions with their reasons and ages to the log
+	 */
+	void LogActiveSuspensions() const;
+
+protected:
+	void SetInputFiltered(bool bFiltered);
+
+public:
+	static UUIInputSuspensionSubsystem* Get(const ULocalPlayer* LocalPlayer);
+
+};
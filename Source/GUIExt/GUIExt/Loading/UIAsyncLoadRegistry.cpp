@@ -0,0 +1,330 @@
+// Copyright (C) 2024 owoDra
+
+#include "UIAsyncLoadRegistry.h"
+
+#include "UIDeveloperSettings.h"
+#include "GUIExtLogs.h"
+
+#include "Engine/AssetManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UIAsyncLoadRegistry)
+
+
+///////////////////////////////////////////////////////////
+// FUIAsyncLoadRequest
+
+void FUIAsyncLoadRequest::Cancel()
+{
+	FUIAsyncLoadRegistry::Get().CancelRequest(AsShared());
+}
+
+
+///////////////////////////////////////////////////////////
+// FUIAsyncLoadRegistry
+
+FUIAsyncLoadRegistry& FUIAsyncLoadRegistry::Get()
+{
+	static FUIAsyncLoadRegistry Registry;
+	return Registry;
+}
+
+
+TSharedPtr<FUIAsyncLoadRequest> FUIAsyncLoadRegistry::RequestAsyncLoad(const FSoftObjectPath& Path, FStreamableDelegate CompleteDelegate, FStreamableDelegate CancelDelegate, TAsyncLoadPriority Priority, FName QueueName)
+{
+	check(IsInGameThread());
+
+	auto Request{ MakeShared<FUIAsyncLoadRequest>(Path, MoveTemp(CompleteDelegate), MoveTemp(CancelDelegate)) };
+	Request->QueueName = QueueName;
+	Request->RequestTime = FPlatformTime::Seconds();
+
+	// Join the load that is already in flight for this path
+
+	if (auto* InFlight{ InFlightLoads.Find(Path) })
+	{
+		UE_LOG(LogGameExt_UI, Verbose, TEXT("Joined in-flight UI load [%s] (Waiters: %d)"), *Path.ToString(), InFlight->Waiters.Num() + 1);
+
+		InFlight->Waiters.Add(Request);
+
+		const auto bStarted{ InFlight->bStarted };
+
+		if (Priority > InFlight->Priority)
+		{
+			InFlight->Priority = Priority;
+
+			if (bStarted)
+			{
+				InFlight->BoostHandles.Add(UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(Path, FStreamableDelegate(), Priority));
+			}
+		}
+
+		if (bStarted)
+		{
+			RecordQueueTime(*Request);
+		}
+		else
+		{
+			StartDeferredLoads();
+		}
+
+		return Request;
+	}
+
+	auto& NewLoad{ InFlightLoads.Add(Path) };
+	NewLoad.LoadId = ++LastLoadId;
+	NewLoad.Priority = Priority;
+	NewLoad.Waiters.Add(Request);
+
+	if (ShouldDeferLoad(Priority))
+	{
+		UE_LOG(LogGameExt_UI, Verbose, TEXT("Deferred UI load [%s] behind loads with a higher priority (Priority: %d)"), *Path.ToString(), Priority);
+	}
+	else
+	{
+		StartLoad(Path);
+	}
+
+	return Request;
+}
+
+TSharedPtr<FUIAsyncLoadRequest> FUIAsyncLoadRegistry::MakeCompletedRequest(const FSoftObjectPath& Path) const
+{
+	auto Request{ MakeShared<FUIAsyncLoadRequest>(Path, FStreamableDelegate(), FStreamableDelegate()) };
+	Request->RequestTime = FPlatformTime::Seconds();
+	Request->bActive = false;
+	Request->bCompleted = true;
+	Request->bStarted = true;
+
+	return Request;
+}
+
+int32 FUIAsyncLoadRegistry::GetNumWaiters(const FSoftObjectPath& Path) const
+{
+	const auto* InFlight{ InFlightLoads.Find(Path) };
+
+	return InFlight ? InFlight->Waiters.Num() : 0;
+}
+
+void FUIAsyncLoadRegistry::Shutdown()
+{
+	auto Loads{ MoveTemp(InFlightLoads) };
+	InFlightLoads.Reset();
+
+	for (auto& KVP : Loads)
+	{
+		ReleaseLoad(KVP.Value, false);
+	}
+}
+
+
+void FUIAsyncLoadRegistry::CancelRequest(const TSharedRef<FUIAsyncLoadRequest>& Request)
+{
+	if (!Request->bActive)
+	{
+		return;
+	}
+
+	Request->bActive = false;
+
+	if (auto* InFlight{ InFlightLoads.Find(Request->Path) })
+	{
+		InFlight->Waiters.Remove(Request);
+
+		// Nobody is waiting for this load anymore
+
+		if (InFlight->Waiters.IsEmpty())
+		{
+			auto Load{ MoveTemp(*InFlight) };
+			InFlightLoads.Remove(Request->Path);
+
+			ReleaseLoad(Load, true);
+
+			StartDeferredLoads();
+		}
+	}
+
+	Request->CancelDelegate.ExecuteIfBound();
+}
+
+
+bool FUIAsyncLoadRegistry::ShouldDeferLoad(TAsyncLoadPriority Priority) const
+{
+	if (!GetDefault<UUIDeveloperSettings>()->bDeferLowerPriorityLoads)
+	{
+		return false;
+	}
+
+	for (const auto& KVP : InFlightLoads)
+	{
+		if (KVP.Value.bStarted && (KVP.Value.Priority > Priority))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FUIAsyncLoadRegistry::StartLoad(const FSoftObjectPath& Path)
+{
+	auto* InFlight{ InFlightLoads.Find(Path) };
+
+	if (!InFlight || InFlight->bStarted)
+	{
+		return;
+	}
+
+	InFlight->bStarted = true;
+
+	for (const auto& Waiter : InFlight->Waiters)
+	{
+		RecordQueueTime(*Waiter);
+	}
+
+	const auto LoadId{ InFlight->LoadId };
+
+	auto Handle
+	{
+		UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(
+			Path,
+			FStreamableDelegate::CreateRaw(this, &FUIAsyncLoadRegistry::HandleLoadCompleted, Path, LoadId),
+			InFlight->Priority
+		)
+	};
+
+	// The load may already have completed (and the entry removed) if everything was resident.
+
+	InFlight = InFlightLoads.Find(Path);
+
+	if (InFlight && (InFlight->LoadId == LoadId))
+	{
+		if (Handle.IsValid())
+		{
+			InFlight->Handle = Handle;
+
+			Handle->BindCancelDelegate(FStreamableDelegate::CreateRaw(this, &FUIAsyncLoadRegistry::HandleLoadCanceled, Path, LoadId));
+		}
+		else
+		{
+			HandleLoadCanceled(Path, LoadId);
+		}
+	}
+}
+
+void FUIAsyncLoadRegistry::StartDeferredLoads()
+{
+	TArray<TPair<FSoftObjectPath, TAsyncLoadPriority>> DeferredLoads;
+
+	for (const auto& KVP : InFlightLoads)
+	{
+		if (!KVP.Value.bStarted)
+		{
+			DeferredLoads.Emplace(KVP.Key, KVP.Value.Priority);
+		}
+	}
+
+	// Start the highest priorities first so that they defer the lower ones again
+
+	DeferredLoads.Sort([](const auto& A, const auto& B) { return A.Value > B.Value; });
+
+	for (const auto& DeferredLoad : DeferredLoads)
+	{
+		if (!ShouldDeferLoad(DeferredLoad.Value))
+		{
+			StartLoad(DeferredLoad.Key);
+		}
+	}
+}
+
+
+void FUIAsyncLoadRegistry::RecordQueueTime(FUIAsyncLoadRequest& Request)
+{
+	if (Request.bStarted)
+	{
+		return;
+	}
+
+	Request.bStarted = true;
+
+	const auto QueueSeconds{ static_cast<float>(FPlatformTime::Seconds() - Request.RequestTime) };
+
+	auto& Stats{ QueueStats.FindOrAdd(Request.QueueName) };
+	Stats.NumRequests++;
+	Stats.TotalQueueSeconds += QueueSeconds;
+	Stats.MaxQueueSeconds = FMath::Max(Stats.MaxQueueSeconds, QueueSeconds);
+}
+
+void FUIAsyncLoadRegistry::ReleaseLoad(FInFlightLoad& Load, bool bCancel)
+{
+	if (Load.Handle.IsValid())
+	{
+		bCancel ? Load.Handle->CancelHandle() : Load.Handle->ReleaseHandle();
+	}
+
+	for (const auto& BoostHandle : Load.BoostHandles)
+	{
+		if (BoostHandle.IsValid())
+		{
+			bCancel ? BoostHandle->CancelHandle() : BoostHandle->ReleaseHandle();
+		}
+	}
+
+	Load.Handle.Reset();
+	Load.BoostHandles.Reset();
+}
+
+
+void FUIAsyncLoadRegistry::HandleLoadCompleted(FSoftObjectPath Path, uint32 LoadId)
+{
+	auto* InFlight{ InFlightLoads.Find(Path) };
+
+	if (!InFlight || (InFlight->LoadId != LoadId))
+	{
+		return;
+	}
+
+	// Copy in case waiters request the same path again while handling callbacks
+
+	auto Load{ MoveTemp(*InFlight) };
+	InFlightLoads.Remove(Path);
+
+	for (const auto& Waiter : Load.Waiters)
+	{
+		if (Waiter->bActive)
+		{
+			Waiter->bActive = false;
+			Waiter->bCompleted = true;
+			Waiter->CompleteDelegate.ExecuteIfBound();
+		}
+	}
+
+	ReleaseLoad(Load, false);
+
+	StartDeferredLoads();
+}
+
+void FUIAsyncLoadRegistry::HandleLoadCanceled(FSoftObjectPath Path, uint32 LoadId)
+{
+	auto* InFlight{ InFlightLoads.Find(Path) };
+
+	if (!InFlight || (InFlight->LoadId != LoadId))
+	{
+		return;
+	}
+
+	auto Load{ MoveTemp(*InFlight) };
+	InFlightLoads.Remove(Path);
+
+	Load.Handle.Reset();
+	ReleaseLoad(Load, true);
+
+	for (const auto& Waiter : Load.Waiters)
+	{
+		if (Waiter->bActive)
+		{
+			Waiter->bActive = false;
+			Waiter->CancelDelegate.ExecuteIfBound();
+		}
+	}
+
+	StartDeferredLoads();
+}
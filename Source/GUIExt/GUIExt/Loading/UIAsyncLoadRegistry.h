@@ -0,0 +1,155 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Engine/StreamableManager.h"
+#include "UObject/SoftObjectPath.h"
+
+#include "UIAsyncLoadRegistry.generated.h"
+
+
+/**
+ * Time the requests of a queue waited before their load was started
+ */
+USTRUCT(BlueprintType)
+struct FUIAsyncLoadQueueStats
+{
+	GENERATED_BODY()
+public:
+	FUIAsyncLoadQueueStats() {}
+
+public:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 NumRequests{ 0 };
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float TotalQueueSeconds{ 0.0f };
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float MaxQueueSeconds{ 0.0f };
+
+};
+
+
+/**
+ * A single waiter on a load shared through FUIAsyncLoadRegistry
+ */
+class GUIEXT_API FUIAsyncLoadRequest : public TSharedFromThis<FUIAsyncLoadRequest>
+{
+	friend class FUIAsyncLoadRegistry;
+
+public:
+	FUIAsyncLoadRequest(const FSoftObjectPath& InPath, FStreamableDelegate InCompleteDelegate, FStreamableDelegate InCancelDelegate)
+		: Path(InPath)
+		, CompleteDelegate(MoveTemp(InCompleteDelegate))
+		, CancelDelegate(MoveTemp(InCancelDelegate))
+	{}
+
+private:
+	FSoftObjectPath Path;
+
+	FStreamableDelegate CompleteDelegate;
+	FStreamableDelegate CancelDelegate;
+
+	FName QueueName{ NAME_None };
+
+	double RequestTime{ 0.0 };
+
+	bool bActive{ true };
+	bool bCompleted{ false };
+	bool bStarted{ false };
+
+public:
+	/**
+	 * Stops waiting for the load and notifies the cancel delegate.
+	 * The load itself is only canceled when no other waiter needs it.
+	 */
+	void Cancel();
+
+	bool IsActive() const { return bActive; }
+	bool HasCompleted() const { return bCompleted; }
+	const FSoftObjectPath& GetPath() const { return Path; }
+
+};
+
+
+/**
+ * Registry shared by every async UI entry point.
+ * Loads in flight are deduplicated by soft path and their completion is fanned out to all waiters in request order.
+ *
+ * Tips:
+ *	A waiter joining a load with a higher priority raises the priority of that load.
+ *	When deferral is enabled in the developer settings, a load is not started while a load with a higher priority is in flight.
+ */
+class GUIEXT_API FUIAsyncLoadRegistry
+{
+public:
+	static FUIAsyncLoadRegistry& Get();
+
+private:
+	struct FInFlightLoad
+	{
+		uint32 LoadId{ 0 };
+
+		TAsyncLoadPriority Priority{ FStreamableManager::DefaultAsyncLoadPriority };
+
+		bool bStarted{ false };
+
+		TSharedPtr<FStreamableHandle> Handle;
+
+		//
+		// Requests for the same path at a higher priority, the loader raises the priority of the package it is already loading
+		//
+		TArray<TSharedPtr<FStreamableHandle>> BoostHandles;
+
+		TArray<TSharedPtr<FUIAsyncLoadRequest>> Waiters;
+	};
+
+	TMap<FSoftObjectPath, FInFlightLoad> InFlightLoads;
+
+	TMap<FName, FUIAsyncLoadQueueStats> QueueStats;
+
+	uint32 LastLoadId{ 0 };
+
+public:
+	/**
+	 * Requests the object at the path to be loaded, joining the load already in flight for the same path if there is one.
+	 * The time the request waits before its load starts is reported under the queue name.
+	 */
+	TSharedPtr<FUIAsyncLoadRequest> RequestAsyncLoad(
+		const FSoftObjectPath& Path
+		, FStreamableDelegate CompleteDelegate
+		, FStreamableDelegate CancelDelegate = FStreamableDelegate()
+		, TAsyncLoadPriority Priority = FStreamableManager::DefaultAsyncLoadPriority
+		, FName QueueName = NAME_None);
+
+	/**
+	 * Returns a request that has already completed, for callers that found the object resident and did not need to load it
+	 */
+	TSharedPtr<FUIAsyncLoadRequest> MakeCompletedRequest(const FSoftObjectPath& Path) const;
+
+	bool IsLoadInFlight(const FSoftObjectPath& Path) const { return InFlightLoads.Contains(Path); }
+
+	int32 GetNumWaiters(const FSoftObjectPath& Path) const;
+
+	FUIAsyncLoadQueueStats GetQueueStats(FName QueueName) const { return QueueStats.FindRef(QueueName); }
+
+	/**
+	 * Drops every load in flight without notifying the waiters
+	 */
+	void Shutdown();
+
+private:
+	void CancelRequest(const TSharedRef<FUIAsyncLoadRequest>& Request);
+
+	bool ShouldDeferLoad(TAsyncLoadPriority Priority) const;
+	void StartLoad(const FSoftObjectPath& Path);
+	void StartDeferredLoads();
+
+	void RecordQueueTime(FUIAsyncLoadRequest& Request);
+	void ReleaseLoad(FInFlightLoad& Load, bool bCancel);
+
+	void HandleLoadCompleted(FSoftObjectPath Path, uint32 LoadId);
+	void HandleLoadCanceled(FSoftObjectPath Path, uint32 LoadId);
+
+};
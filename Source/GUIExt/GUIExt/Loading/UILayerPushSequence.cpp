@@ -0,0 +1,169 @@
+// Copyright (C) 2024 owoDra
+
+#include "UILayerPushSequence.h"
+
+#include "UILayout.h"
+#include "Loading/UIAsyncLoadRegistry.h"
+#include "GUIExtLogs.h"
+
+#include "CommonActivatableWidget.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UILayerPushSequence)
+
+
+FUILayerPushSequence::FUILayerPushSequence(UUILayout* InLayout, const TArray<FUILayerPushSequenceEntry>& InEntries, FStateFunc InStateFunc)
+	: Layout(InLayout)
+	, Entries(InEntries)
+	, StateFunc(MoveTemp(InStateFunc))
+{
+}
+
+
+void FUILayerPushSequence::Start(bool bSuspendInputUntilComplete)
+{
+	check(!bActive);
+
+	auto* PinnedLayout{ Layout.Get() };
+
+	if (!PinnedLayout || Entries.IsEmpty())
+	{
+		return;
+	}
+
+	bActive = true;
+	SelfReference = AsShared();
+
+	if (bSuspendInputUntilComplete)
+	{
+		static const auto NAME_PushingWidgetSequence{ FName(TEXT("PushingWidgetSequence")) };
+
+		if (auto* SuspensionSubsystem{ UUIInputSuspensionSubsystem::Get(PinnedLayout->GetOwningLocalPlayer()) })
+		{
+			InputSuspension = SuspensionSubsystem->SuspendInputScoped(NAME_PushingWidgetSequence);
+		}
+	}
+
+	LoadedEntries.Init(false, Entries.Num());
+
+	// Keep a reference in case an entry completes synchronously and finishes the sequence
+
+	auto KeepAlive{ AsShared() };
+
+	for (auto Index{ 0 }; Index < Entries.Num(); ++Index)
+	{
+		if (!bActive)
+		{
+			break;
+		}
+
+		LoadRequests.Add(
+			FUIAsyncLoadRegistry::Get().RequestAsyncLoad(
+				Entries[Index].WidgetClass.ToSoftObjectPath(),
+				FStreamableDelegate::CreateSP(this, &FUILayerPushSequence::HandleEntryLoaded, Index),
+				FStreamableDelegate::CreateSP(this, &FUILayerPushSequence::HandleEntryCanceled, Index),
+				PinnedLayout->GetLayerLoadPriority(Entries[Index].LayerTag),
+				Entries[Index].LayerTag.GetTagName()
+			)
+		);
+	}
+}
+
+void FUILayerPushSequence::Cancel()
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	auto KeepAlive{ MoveTemp(SelfReference) };
+
+	bActive = false;
+
+	for (const auto& LoadRequest : LoadRequests)
+	{
+		if (LoadRequest.IsValid())
+		{
+			LoadRequest->Cancel();
+		}
+	}
+
+	LoadRequests.Reset();
+	InputSuspension.Reset();
+
+	UE_LOG(LogGameExt_UI, Verbose, TEXT("Push sequence canceled after %d of %d entries"), NextEntryIndex, Entries.Num());
+
+	if (StateFunc)
+	{
+		StateFunc(EAsyncWidgetLayerState::Canceled, NextEntryIndex, nullptr);
+	}
+}
+
+
+void FUILayerPushSequence::HandleEntryLoaded(int32 EntryIndex)
+{
+	if (bActive && LoadedEntries.IsValidIndex(EntryIndex))
+	{
+		LoadedEntries[EntryIndex] = true;
+
+		PushReadyEntries();
+	}
+}
+
+void FUILayerPushSequence::HandleEntryCanceled(int32 EntryIndex)
+{
+	// Later entries cannot be pushed without this one
+
+	Cancel();
+}
+
+void FUILayerPushSequence::PushReadyEntries()
+{
+	auto KeepAlive{ AsShared() };
+
+	while (bActive && LoadedEntries.IsValidIndex(NextEntryIndex) && LoadedEntries[NextEntryIndex])
+	{
+		auto* PinnedLayout{ Layout.Get() };
+		const auto& Entry{ Entries[NextEntryIndex] };
+
+		if (!PinnedLayout || !Entry.WidgetClass.Get())
+		{
+			Cancel();
+			return;
+		}
+
+		const auto EntryIndex{ NextEntryIndex++ };
+
+		auto* Widget
+		{
+			PinnedLayout->PushWidgetToLayerStack<UCommonActivatableWidget>(
+				Entry.LayerTag, Entry.WidgetClass.Get(), [this, EntryIndex](UCommonActivatableWidget& WidgetToInit)
+				{
+					if (StateFunc)
+					{
+						StateFunc(EAsyncWidgetLayerState::Initialize, EntryIndex, &WidgetToInit);
+					}
+				}
+			)
+		};
+
+		if (StateFunc)
+		{
+			StateFunc(EAsyncWidgetLayerState::AfterPush, EntryIndex, Widget);
+		}
+	}
+
+	if (bActive && (NextEntryIndex >= Entries.Num()))
+	{
+		Finish();
+	}
+}
+
+void FUILayerPushSequence::Finish()
+{
+	auto KeepAlive{ MoveTemp(SelfReference) };
+
+	bActive = false;
+
+	LoadRequests.Reset();
+	InputSuspension.Reset();
+}
@@ -0,0 +1,100 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Input/UIInputSuspensionSubsystem.h"
+
+#include "GameplayTagContainer.h"
+
+#include "UILayerPushSequence.generated.h"
+
+class FUIAsyncLoadRequest;
+class UCommonActivatableWidget;
+class UUILayout;
+enum class EAsyncWidgetLayerState : uint8;
+
+
+/**
+ * A widget class pushed to a layer as part of a push sequence
+ */
+USTRUCT(BlueprintType)
+struct FUILayerPushSequenceEntry
+{
+	GENERATED_BODY()
+public:
+	FUILayerPushSequenceEntry() {}
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Categories = "UI.Layer"))
+	FGameplayTag LayerTag;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TSoftClassPtr<UCommonActivatableWidget> WidgetClass;
+
+};
+
+
+/**
+ * Several widget classes loaded in parallel and pushed in their declared order
+ *
+ * Tips:
+ *	Each entry is pushed as soon as its class and the classes of all entries before it are loaded.
+ *	If the load of an entry is canceled, the rest of the sequence is canceled as well.
+ */
+class GUIEXT_API FUILayerPushSequence : public TSharedFromThis<FUILayerPushSequence>
+{
+public:
+	using FStateFunc = TFunction<void(EAsyncWidgetLayerState State, int32 EntryIndex, UCommonActivatableWidget* Widget)>;
+
+	FUILayerPushSequence(UUILayout* InLayout, const TArray<FUILayerPushSequenceEntry>& InEntries, FStateFunc InStateFunc);
+
+private:
+	TWeakObjectPtr<UUILayout> Layout;
+
+	TArray<FUILayerPushSequenceEntry> Entries;
+
+	TArray<TSharedPtr<FUIAsyncLoadRequest>> LoadRequests;
+
+	TArray<bool> LoadedEntries;
+
+	FStateFunc StateFunc;
+
+	//
+	// A single suspension held for the whole sequence
+	//
+	FUIInputSuspensionHandle InputSuspension;
+
+	//
+	// Keeps the sequence alive while its loads are in flight
+	//
+	TSharedPtr<FUILayerPushSequence> SelfReference;
+
+	int32 NextEntryIndex{ 0 };
+
+	bool bActive{ false };
+
+public:
+	/**
+	 * Starts loading every entry at once
+	 */
+	void Start(bool bSuspendInputUntilComplete);
+
+	/**
+	 * Cancels the loads of the entries that have not been pushed yet
+	 */
+	void Cancel();
+
+	bool IsActive() const { return bActive; }
+
+	int32 GetNumPushed() const { return NextEntryIndex; }
+
+	int32 GetNumEntries() const { return Entries.Num(); }
+
+private:
+	void HandleEntryLoaded(int32 EntryIndex);
+	void HandleEntryCanceled(int32 EntryIndex);
+
+	void PushReadyEntries();
+	void Finish();
+
+};
@@ -0,0 +1,317 @@
+// Copyright (C) 2024 owoDra
+
+#include "UIUsagePredictor.h"
+
+#include "GUIExtLogs.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UIUsagePredictor)
+
+
+namespace UIUsagePredictor
+{
+	static const uint32 HistoryFileMagic{ 0x48555547 };	// 'GUUH'
+	static const int32 HistoryFileVersion{ 1 };
+
+	//
+	// Maximum number of records kept for each previous widget class
+	//
+	static const int32 MaxRecordsPerContext{ 32 };
+
+	//
+	// Memory assumed for a widget class that has never been measured
+	//
+	static const int64 DefaultClassSizeEstimate{ 256 * 1024 };
+}
+
+
+FUIUsagePredictor::~FUIUsagePredictor()
+{
+	ReleasePreloads();
+}
+
+
+void FUIUsagePredictor::Initialize()
+{
+	SessionStartTime = FPlatformTime::Seconds();
+
+	LoadHistory();
+}
+
+void FUIUsagePredictor::Deinitialize()
+{
+	SaveHistory();
+
+	ReleasePreloads();
+}
+
+
+void FUIUsagePredictor::RecordUsage(const FSoftObjectPath& PreviousClass, FGameplayTag LayerTag, UClass* UsedClass)
+{
+	if (!UsedClass)
+	{
+		return;
+	}
+
+	const auto UsedPath{ FSoftObjectPath(UsedClass) };
+
+	// Score the last prediction
+
+	if (PredictedClasses.Contains(UsedPath))
+	{
+		Stats.Hits++;
+	}
+	else if (bHasPendingPrediction)
+	{
+		Stats.Misses++;
+	}
+
+	PredictedClasses.Reset();
+	bHasPendingPrediction = false;
+
+	// The used widget keeps the class loaded from now on
+
+	if (auto* Preloaded{ PreloadedClasses.Find(UsedPath) })
+	{
+		if (Preloaded->Handle.IsValid())
+		{
+			Preloaded->Handle->ReleaseHandle();
+		}
+
+		PreloadedClasses.Remove(UsedPath);
+	}
+
+	// Update the history
+
+	const auto UsedClassString{ UsedPath.ToString() };
+	const auto LayerString{ LayerTag.ToString() };
+	const auto TimeBucket{ GetCurrentTimeBucket() };
+
+	auto& Records{ History.FindOrAdd(PreviousClass.ToString()) };
+
+	auto* Record
+	{
+		Records.FindByPredicate(
+			[&](const FUsageRecord& Item)
+			{
+				return (Item.NextClass == UsedClassString) && (Item.LayerTag == LayerString) && (Item.TimeBucket == TimeBucket);
+			}
+		)
+	};
+
+	if (Record)
+	{
+		Record->Count++;
+	}
+	else
+	{
+		if (Records.Num() >= UIUsagePredictor::MaxRecordsPerContext)
+		{
+			Records.Sort([](const FUsageRecord& A, const FUsageRecord& B) { return A.Count > B.Count; });
+			Records.SetNum(UIUsagePredictor::MaxRecordsPerContext - 1);
+		}
+
+		auto& NewRecord{ Records.AddDefaulted_GetRef() };
+		NewRecord.NextClass = UsedClassString;
+		NewRecord.LayerTag = LayerString;
+		NewRecord.TimeBucket = TimeBucket;
+		NewRecord.Count = 1;
+	}
+
+	// Only the class object is measured, the assets referenced by its widget tree are not included
+
+	ClassSizes.Add(UsedClassString, UsedClass->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal));
+}
+
+void FUIUsagePredictor::GetPredictions(const FSoftObjectPath& PreviousClass, int32 MaxResults, TArray<FSoftObjectPath>& OutClasses) const
+{
+	const auto* Records{ History.Find(PreviousClass.ToString()) };
+
+	if (!Records || (MaxResults <= 0))
+	{
+		return;
+	}
+
+	// Records from the same phase of the session count double
+
+	const auto TimeBucket{ GetCurrentTimeBucket() };
+
+	TMap<FString, uint32> Scores;
+
+	for (const auto& Record : *Records)
+	{
+		Scores.FindOrAdd(Record.NextClass) += (Record.TimeBucket == TimeBucket) ? (Record.Count * 2) : Record.Count;
+	}
+
+	Scores.ValueSort([](uint32 A, uint32 B) { return A > B; });
+
+	for (const auto& KVP : Scores)
+	{
+		if (OutClasses.Num() >= MaxResults)
+		{
+			break;
+		}
+
+		OutClasses.Add(FSoftObjectPath(KVP.Key));
+	}
+}
+
+void FUIUsagePredictor::PreloadPredictions(const FSoftObjectPath& PreviousClass, int32 MaxClasses, int64 MemoryBudgetBytes)
+{
+	TArray<FSoftObjectPath> Predictions;
+	GetPredictions(PreviousClass, MaxClasses, Predictions);
+
+	// Release the previous predictions that are no longer likely
+
+	int64 UsedBytes{ 0 };
+
+	for (auto It{ PreloadedClasses.CreateIterator() }; It; ++It)
+	{
+		if (Predictions.Contains(It.Key()))
+		{
+			UsedBytes += It.Value().EstimatedBytes;
+			continue;
+		}
+
+		Stats.WastedBytes += It.Value().EstimatedBytes;
+
+		if (It.Value().Handle.IsValid())
+		{
+			It.Value().Handle->ReleaseHandle();
+		}
+
+		It.RemoveCurrent();
+	}
+
+	// Preload the new predictions within the budget
+
+	auto& StreamableManager{ UAssetManager::Get().GetStreamableManager() };
+
+	PredictedClasses.Reset();
+
+	for (const auto& Path : Predictions)
+	{
+		// Resident classes are still predicted so that they can be scored, they just need no preload
+
+		PredictedClasses.Add(Path);
+		Stats.Predictions++;
+
+		if (PreloadedClasses.Contains(Path) || Path.ResolveObject())
+		{
+			continue;
+		}
+
+		const auto MeasuredBytes{ ClassSizes.FindRef(Path.ToString()) };
+		const auto EstimatedBytes{ (MeasuredBytes > 0) ? MeasuredBytes : UIUsagePredictor::DefaultClassSizeEstimate };
+
+		if ((UsedBytes + EstimatedBytes) > MemoryBudgetBytes)
+		{
+			continue;
+		}
+
+		auto& Preloaded{ PreloadedClasses.Add(Path) };
+		Preloaded.EstimatedBytes = EstimatedBytes;
+		Preloaded.Handle = StreamableManager.RequestAsyncLoad(Path, FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority);
+
+		UsedBytes += EstimatedBytes;
+
+		UE_LOG(LogGameExt_UI, Verbose, TEXT("Preloading predicted widget class [%s] (%lld bytes)"), *Path.ToString(), EstimatedBytes);
+	}
+
+	// Without any prediction there is nothing to score the next usage against
+
+	bHasPendingPrediction = !PredictedClasses.IsEmpty();
+}
+
+void FUIUsagePredictor::ReleasePreloads()
+{
+	for (const auto& KVP : PreloadedClasses)
+	{
+		Stats.WastedBytes += KVP.Value.EstimatedBytes;
+
+		if (KVP.Value.Handle.IsValid())
+		{
+			KVP.Value.Handle->ReleaseHandle();
+		}
+	}
+
+	PreloadedClasses.Reset();
+	PredictedClasses.Reset();
+
+	bHasPendingPrediction = false;
+}
+
+
+uint8 FUIUsagePredictor::GetCurrentTimeBucket() const
+{
+	const auto Minutes{ (FPlatformTime::Seconds() - SessionStartTime) / 60.0 };
+
+	return (Minutes < 1.0) ? 0 : (Minutes < 5.0) ? 1 : (Minutes < 15.0) ? 2 : (Minutes < 60.0) ? 3 : 4;
+}
+
+void FUIUsagePredictor::LoadHistory()
+{
+	History.Reset();
+	ClassSizes.Reset();
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *GetHistoryFilePath(), FILEREAD_Silent))
+	{
+		return;
+	}
+
+	FMemoryReader Reader(Bytes);
+
+	uint32 Magic{ 0 };
+	int32 Version{ 0 };
+	Reader << Magic << Version;
+
+	if ((Magic != UIUsagePredictor::HistoryFileMagic) || (Version != UIUsagePredictor::HistoryFileVersion))
+	{
+		UE_LOG(LogGameExt_UI, Log, TEXT("Discarded UI usage history with unknown format (Version: %d)"), Version);
+		return;
+	}
+
+	Reader << History << ClassSizes;
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogGameExt_UI, Warning, TEXT("Failed to read UI usage history [%s]"), *GetHistoryFilePath());
+
+		History.Reset();
+		ClassSizes.Reset();
+	}
+}
+
+void FUIUsagePredictor::SaveHistory()
+{
+	if (History.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	auto Magic{ UIUsagePredictor::HistoryFileMagic };
+	auto Version{ UIUsagePredictor::HistoryFileVersion };
+	Writer << Magic << Version;
+
+	Writer << History << ClassSizes;
+
+	if (!FFileHelper::SaveArrayToFile(Bytes, *GetHistoryFilePath()))
+	{
+		UE_LOG(LogGameExt_UI, Warning, TEXT("Failed to save UI usage history [%s]"), *GetHistoryFilePath());
+	}
+}
+
+FString FUIUsagePredictor::GetHistoryFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("GUIExt") / TEXT("UIUsageHistory.bin");
+}
@@ -0,0 +1,146 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "UObject/SoftObjectPath.h"
+
+#include "UIUsagePredictor.generated.h"
+
+struct FStreamableHandle;
+
+
+/**
+ * How well the usage predictions matched the widget classes that were actually used
+ */
+USTRUCT(BlueprintType)
+struct FUIUsagePredictionStats
+{
+	GENERATED_BODY()
+public:
+	FUIUsagePredictionStats() {}
+
+public:
+	//
+	// Number of widget classes predicted, whether they had to be preloaded or were already loaded
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Predictions{ 0 };
+
+	//
+	// Number of used widget classes that had been predicted
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Hits{ 0 };
+
+	//
+	// Number of used widget classes that were not predicted, while a prediction was made
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Misses{ 0 };
+
+	//
+	// Estimated memory of the preloaded widget classes released without being used
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int64 WastedBytes{ 0 };
+
+};
+
+
+/**
+ * Learns which widget classes are used after each other and preloads the ones most likely to be used next
+ *
+ * Tips:
+ *	The history is keyed by the previously used widget class (empty at layout creation), and each record keeps
+ *	the layer and the time since the session start so that predictions favor the current phase of the session.
+ */
+class GUIEXT_API FUIUsagePredictor
+{
+public:
+	FUIUsagePredictor() {}
+	~FUIUsagePredictor();
+
+private:
+	struct FUsageRecord
+	{
+		FString NextClass;
+		FString LayerTag;
+		uint8 TimeBucket{ 0 };
+		uint32 Count{ 0 };
+
+		friend FArchive& operator<<(FArchive& Ar, FUsageRecord& Record)
+		{
+			Ar << Record.NextClass << Record.LayerTag << Record.TimeBucket << Record.Count;
+			return Ar;
+		}
+	};
+
+	struct FPreloadedClass
+	{
+		TSharedPtr<FStreamableHandle> Handle;
+		int64 EstimatedBytes{ 0 };
+	};
+
+	//
+	// Usage records keyed by the class path of the previously used widget
+	//
+	TMap<FString, TArray<FUsageRecord>> History;
+
+	//
+	// Estimated memory size of the widget classes that have been used, keyed by class path
+	//
+	TMap<FString, int64> ClassSizes;
+
+	TMap<FSoftObjectPath, FPreloadedClass> PreloadedClasses;
+
+	//
+	// Classes predicted by the last prediction, including the ones that were already loaded and did not need a preload
+	//
+	TSet<FSoftObjectPath> PredictedClasses;
+
+	FUIUsagePredictionStats Stats;
+
+	double SessionStartTime{ 0.0 };
+
+	bool bHasPendingPrediction{ false };
+
+public:
+	/**
+	 * Starts a new session and loads the saved history
+	 */
+	void Initialize();
+
+	/**
+	 * Saves the history and releases the preloaded classes
+	 */
+	void Deinitialize();
+
+	/**
+	 * Records that the widget class was used after the previous one
+	 */
+	void RecordUsage(const FSoftObjectPath& PreviousClass, FGameplayTag LayerTag, UClass* UsedClass);
+
+	/**
+	 * Returns the widget classes most likely to be used after the previous one, best first
+	 */
+	void GetPredictions(const FSoftObjectPath& PreviousClass, int32 MaxResults, TArray<FSoftObjectPath>& OutClasses) const;
+
+	/**
+	 * Preloads the predicted widget classes within the memory budget and releases the previous predictions that are no longer likely
+	 */
+	void PreloadPredictions(const FSoftObjectPath& PreviousClass, int32 MaxClasses, int64 MemoryBudgetBytes);
+
+	void ReleasePreloads();
+
+	const FUIUsagePredictionStats& GetStats() const { return Stats; }
+
+protected:
+	uint8 GetCurrentTimeBucket() const;
+
+	void LoadHistory();
+	void SaveHistory();
+
+	static FString GetHistoryFilePath();
+
+};
@@ -0,0 +1,209 @@
+// Copyright (C) 2024 owoDra
+
+#include "UIFrameScheduler.h"
+
+#include "UIManagerSubsystem.h"
+#include "UIDeveloperSettings.h"
+#include "GUIExtLogs.h"
+
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(UIFrameScheduler)
+
+
+static TAutoConsoleVariable<float> CVarFrameSchedulerBudgetMs(
+	TEXT("GUIExt.FrameScheduler.BudgetMs"),
+	-1.0f,
+	TEXT("Per-frame budget of the UI frame scheduler in milliseconds, a negative value uses the developer settings"),
+	ECVF_Scalability
+);
+
+
+FUIFrameScheduler::~FUIFrameScheduler()
+{
+	Reset();
+}
+
+
+void FUIFrameScheduler::Submit(EUITaskPriority Priority, FTask Task, FName DebugName)
+{
+	check(IsInGameThread());
+
+	if (!Task || (Priority >= EUITaskPriority::MAX))
+	{
+		return;
+	}
+
+	auto& QueuedTask{ Queues[static_cast<uint8>(Priority)].AddDefaulted_GetRef() };
+	QueuedTask.Task = MoveTemp(Task);
+	QueuedTask.DebugName = DebugName;
+	QueuedTask.SubmitTime = FPlatformTime::Seconds();
+
+	if (!TickHandle.IsValid())
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FUIFrameScheduler::Tick), 0.0f);
+	}
+}
+
+void FUIFrameScheduler::Reset()
+{
+	for (auto& Queue : Queues)
+	{
+		Queue.Reset();
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	TickHandle.Reset();
+}
+
+int32 FUIFrameScheduler::GetBacklog() const
+{
+	auto Backlog{ 0 };
+
+	for (const auto& Queue : Queues)
+	{
+		Backlog += Queue.Num();
+	}
+
+	return Backlog;
+}
+
+FUIFrameSchedulerStats FUIFrameScheduler::GetStats() const
+{
+	auto Result{ Stats };
+	Result.Backlog = GetBacklog();
+
+	return Result;
+}
+
+void FUIFrameScheduler::LogStats() const
+{
+	UE_LOG(LogGameExt_UI, Log, TEXT("UI frame scheduler: Budget %.2fms, Last frame %.2fms (%d tasks), Over budget frames %d, Promotions %d, Total %lld"),
+		Stats.BudgetMs, Stats.LastFrameMs, Stats.LastFrameTasks, Stats.OverBudgetFrames, Stats.Promotions, Stats.TotalTasks);
+
+	for (auto Index{ 0 }; Index < NumPriorities; ++Index)
+	{
+		UE_LOG(LogGameExt_UI, Log, TEXT("  [%s] Backlog: %d"), *UEnum::GetValueAsString(static_cast<EUITaskPriority>(Index)), Queues[Index].Num());
+	}
+}
+
+float FUIFrameScheduler::GetBudgetMs()
+{
+	const auto OverrideBudgetMs{ CVarFrameSchedulerBudgetMs.GetValueOnGameThread() };
+
+	return (OverrideBudgetMs >= 0.0f) ? OverrideBudgetMs : GetDefault<UUIDeveloperSettings>()->FrameSchedulerBudgetMs;
+}
+
+
+bool FUIFrameScheduler::Tick(float DeltaTime)
+{
+	const auto StartTime{ FPlatformTime::Seconds() };
+	const auto BudgetSeconds{ GetBudgetMs() / 1000.0 };
+
+	PromoteStarvedTasks(StartTime);
+
+	auto NumExecuted{ 0 };
+	auto Elapsed{ 0.0 };
+
+	for (auto Index{ 0 }; Index < NumPriorities; ++Index)
+	{
+		const auto bIgnoreBudget{ static_cast<EUITaskPriority>(Index) == EUITaskPriority::Critical };
+
+		// Tasks submitted while executing are appended and picked up in the same pass if the budget allows
+
+		auto NumConsumed{ 0 };
+
+		while (Queues[Index].IsValidIndex(NumConsumed))
+		{
+			// Always make progress, even if the budget is smaller than a single task
+
+			if (!bIgnoreBudget && (NumExecuted > 0) && (Elapsed >= BudgetSeconds))
+			{
+				break;
+			}
+
+			auto Task{ MoveTemp(Queues[Index][NumConsumed].Task) };
+			++NumConsumed;
+
+			Task();
+
+			++NumExecuted;
+			Elapsed = FPlatformTime::Seconds() - StartTime;
+		}
+
+		// A task may have reset the scheduler
+
+		Queues[Index].RemoveAt(0, FMath::Min(NumConsumed, Queues[Index].Num()));
+	}
+
+	Stats.BudgetMs = static_cast<float>(BudgetSeconds * 1000.0);
+	Stats.LastFrameMs = static_cast<float>(Elapsed * 1000.0);
+	Stats.LastFrameTasks = NumExecuted;
+	Stats.TotalTasks += NumExecuted;
+
+	if (Elapsed > BudgetSeconds)
+	{
+		Stats.OverBudgetFrames++;
+	}
+
+	// Stop ticking until something is submitted again
+
+	if (GetBacklog() == 0)
+	{
+		TickHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void FUIFrameScheduler::PromoteStarvedTasks(double Now)
+{
+	const auto StarvationSeconds{ GetDefault<UUIDeveloperSettings>()->FrameSchedulerStarvationSeconds };
+
+	if (StarvationSeconds <= 0.0f)
+	{
+		return;
+	}
+
+	// Walk down from Normal so that a task is promoted by at most one class per frame, Critical is never promoted into
+
+	for (auto Index{ static_cast<int32>(EUITaskPriority::Normal) }; Index < NumPriorities; ++Index)
+	{
+		auto& Queue{ Queues[Index] };
+		auto NumStarved{ 0 };
+
+		// Queues are in submission order, so the starved tasks are at the head
+
+		while (Queue.IsValidIndex(NumStarved) && ((Now - Queue[NumStarved].SubmitTime) >= StarvationSeconds))
+		{
+			auto& Promoted{ Queues[Index - 1].Emplace_GetRef(MoveTemp(Queue[NumStarved])) };
+			Promoted.SubmitTime = Now;
+
+			++NumStarved;
+		}
+
+		Queue.RemoveAt(0, NumStarved);
+		Stats.Promotions += NumStarved;
+	}
+}
+
+
+static FAutoConsoleCommandWithWorld FrameSchedulerStatsCommand(
+	TEXT("GUIExt.FrameSchedulerStats"),
+	TEXT("Writes the budget use and backlog of the UI frame scheduler to the log"),
+	FConsoleCommandWithWorldDelegate::CreateStatic(
+		[](UWorld* World)
+		{
+			if (auto* GameInstance{ World ? World->GetGameInstance() : nullptr })
+			{
+				if (const auto* UIManager{ GameInstance->GetSubsystem<UUIManagerSubsystem>() })
+				{
+					UIManager->GetFrameScheduler().LogStats();
+				}
+			}
+		}
+	)
+);
@@ -0,0 +1,144 @@
+// Copyright (C) 2024 owoDra
+
+#pragma once
+
+#include "Containers/Ticker.h"
+
+#include "UIFrameScheduler.generated.h"
+
+
+/**
+ * Priority class of a deferred UI task
+ */
+UENUM(BlueprintType)
+enum class EUITaskPriority : uint8
+{
+	Critical,	// Always executed on the next frame, regardless of the budget
+
+	High,
+
+	Normal,
+
+	Low,
+
+	MAX UMETA(Hidden)
+};
+
+
+/**
+ * Budget use and backlog of the UI frame scheduler
+ */
+USTRUCT(BlueprintType)
+struct FUIFrameSchedulerStats
+{
+	GENERATED_BODY()
+public:
+	FUIFrameSchedulerStats() {}
+
+public:
+	//
+	// Budget of the last frame that executed tasks, in milliseconds
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float BudgetMs{ 0.0f };
+
+	//
+	// Time spent executing tasks in the last frame that executed tasks, in milliseconds
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float LastFrameMs{ 0.0f };
+
+	//
+	// Number of tasks executed in the last frame that executed tasks
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 LastFrameTasks{ 0 };
+
+	//
+	// Number of tasks still waiting to be executed
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Backlog{ 0 };
+
+	//
+	// Number of frames whose tasks took longer than the budget
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 OverBudgetFrames{ 0 };
+
+	//
+	// Number of tasks moved to a higher priority class because they waited too long
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Promotions{ 0 };
+
+	//
+	// Number of tasks executed since the scheduler was created
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int64 TotalTasks{ 0 };
+
+};
+
+
+/**
+ * Runs deferred UI tasks on the game thread within a per-frame time budget
+ *
+ * Tips:
+ *	Tasks run in priority order and in submission order within a priority class.
+ *	A task that waited longer than the starvation time is promoted to the class above.
+ *	The budget comes from the developer settings and can be overridden with GUIExt.FrameScheduler.BudgetMs per device profile or scalability level.
+ *	The scheduler only ticks while it has a backlog.
+ */
+class GUIEXT_API FUIFrameScheduler
+{
+public:
+	FUIFrameScheduler() {}
+	~FUIFrameScheduler();
+
+	using FTask = TUniqueFunction<void()>;
+
+private:
+	struct FQueuedTask
+	{
+		FTask Task;
+		FName DebugName;
+		double SubmitTime{ 0.0 };
+	};
+
+	static constexpr int32 NumPriorities{ static_cast<int32>(EUITaskPriority::MAX) };
+
+	TArray<FQueuedTask> Queues[NumPriorities];
+
+	FTSTicker::FDelegateHandle TickHandle;
+
+	FUIFrameSchedulerStats Stats;
+
+public:
+	/**
+	 * Queues the task to be executed on a later frame. Must be called on the game thread.
+	 */
+	void Submit(EUITaskPriority Priority, FTask Task, FName DebugName = NAME_None);
+
+	/**
+	 * Drops every queued task without executing it
+	 */
+	void Reset();
+
+	int32 GetBacklog() const;
+
+	FUIFrameSchedulerStats GetStats() const;
+
+	/**
+	 * Writes the stats and the backlog of each priority class to the log
+	 */
+	void LogStats() const;
+
+	static float GetBudgetMs();
+
+protected:
+	bool Tick(float DeltaTime);
+
+	void PromoteStarvedTasks(double Now);
+
+};
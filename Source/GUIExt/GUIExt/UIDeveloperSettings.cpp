@@ -2,6 +2,8 @@
 
 #include "UIDeveloperSettings.h"
 
+#include "GameplayTag/GUIETags_UI.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UIDeveloperSettings)
 
 
@@ -9,4 +11,9 @@ UUIDeveloperSettings::UUIDeveloperSettings()
 {
 	CategoryName = TEXT("Game XXX Extension");
 	SectionName = TEXT("Game UI Extension");
+
+	LayerLoadPriorities.Add(TAG_UI_Layer_Modal, 300);
+	LayerLoadPriorities.Add(TAG_UI_Layer_Menu, 200);
+	LayerLoadPriorities.Add(TAG_UI_Layer_GameMenu, 100);
+	LayerLoadPriorities.Add(TAG_UI_Layer_Game, 0);
 }
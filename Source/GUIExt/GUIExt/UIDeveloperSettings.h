@@ -4,6 +4,10 @@
 
 #include "Engine/DeveloperSettings.h"
 
+#include "CommonInputModeTypes.h"
+#include "Engine/EngineBaseTypes.h"
+#include "GameplayTagContainer.h"
+
 #include "UIDeveloperSettings.generated.h"
 
 
@@ -24,5 +28,88 @@ public:
 	UPROPERTY(Config, EditAnywhere, Category = "General", meta = (MetaClass = "/Script/GUIExt.UIPolicy"))
 	FSoftClassPath DefaultUIPolicyClass;
 
+	//
+	// If true, bShowHUD of every player's HUD is checked each frame so that HUD classes not derived from AUIHUD also show and hide the root layout.
+	// AUIHUD notifies its changes itself and does not need this.
+	//
+	UPROPERTY(Config, EditAnywhere, Category = "General")
+	bool bPollShowHUD{ false };
+
+	///////////////////////////////////////////////
+	// Loading
+public:
+	//
+	// If true, an async push of a widget class to a layer that is still waiting for the same class joins that push instead of pushing a second instance
+	//
+	UPROPERTY(Config, EditAnywhere, Category = "Loading")
+	bool bCollapseDuplicateLayerPushes{ false };
+
+	//
+	// If true, the UI manager learns which widget classes are used after each other and preloads the ones likely to be used next
+	//
+	UPROPERTY(Config, EditAnywhere, Category = "Loading")
+	bool bEnablePredictivePreloading{ false };
+
+	//
+	// Maximum number of predicted widget classes preloaded at once
+	//
+	UPROPERTY(Config, EditAnywhere, Category = "Loading", meta = (EditCondition = "bEnablePredictivePreloading", ClampMin = 1))
+	int32 MaxPredictedWidgetClasses{ 3 };
+
+	//
+	// Estimated memory that the predicted widget classes may use at once, in kilobytes.
+	// The estimate is the size of the widget class objects only, the textures and other assets referenced by their widget trees are not counted.
+	//
+	UPROPERTY(Config, EditAnywhere, Category = "Loading", meta = (EditCondition = "bEnablePredictivePreloading", ClampMin = 0, Units = "Kilobytes"))
+	int32 PredictivePreloadBudgetKB{ 4096 };
+
+	//
+	// Load priority of async pushes to each layer, a layer without an entry uses the entry of its closest parent tag
+	//
+	UPROPERTY(Config, EditAnywhere, Category = "Loading", meta = (Categories = "UI.Layer", ForceInlineRow))
+	TMap<FGameplayTag, int32> LayerLoadPriorities;
+
+	//
+	// If true, an async UI load does not start while a load with a higher priority is in flight
+	//
+	UPROPERTY(Config, EditAnywhere, Category = "Loading")
+	bool bDeferLowerPriorityLoads{ false };
+
+	///////////////////////////////////////////////
+	// Input
+public:
+	//
+	// If true, the input configs of the active widgets are resolved once per frame by the input config subsystem and only applied when they change
+	//
+	UPROPERTY(Config, EditAnywhere, Category = "Input")
+	bool bArbitrateInputConfig{ false };
+
+	//
+	// Input mode applied by the input config subsystem when no active widget wants an input config
+	//
+	UPROPERTY(Config, EditAnywhere, Category = "Input", meta = (EditCondition = "bArbitrateInputConfig"))
+	ECommonInputMode FallbackInputMode{ ECommonInputMode::Game };
+
+	//
+	// Mouse capture mode applied by the input config subsystem when no active widget wants an input config
+	//
+	UPROPERTY(Config, EditAnywhere, Category = "Input", meta = (EditCondition = "bArbitrateInputConfig"))
+	EMouseCaptureMode FallbackMouseCaptureMode{ EMouseCaptureMode::CapturePermanently };
+
+	///////////////////////////////////////////////
+	// Scheduling
+public:
+	//
+	// Time the UI frame scheduler may spend on deferred tasks each frame, can be overridden per device profile or scalability level with GUIExt.FrameScheduler.BudgetMs
+	//
+	UPROPERTY(Config, EditAnywhere, Category = "Scheduling", meta = (ClampMin = 0, Units = "Milliseconds"))
+	float FrameSchedulerBudgetMs{ 2.0f };
+
+	//
+	// Time a deferred task may wait before it is promoted to the priority class above, zero disables promotion
+	//
+	UPROPERTY(Config, EditAnywhere, Category = "Scheduling", meta = (ClampMin = 0, Units = "Seconds"))
+	float FrameSchedulerStarvationSeconds{ 0.5f };
+
 };
 
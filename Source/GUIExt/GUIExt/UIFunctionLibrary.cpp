@@ -5,6 +5,7 @@
 #include "UIManagerSubsystem.h"
 #include "UIPolicy.h"
 #include "UILayout.h"
+#include "Input/UIInputSuspensionSubsystem.h"
 
 #include "Player/GFCLocalPlayer.h"
 
@@ -17,8 +18,6 @@
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UIFunctionLibrary)
 
 
-int32 UUIFunctionLibrary::InputSuspensions = 0;
-
 ECommonInputType UUIFunctionLibrary::GetOwningPlayerInputType(const UUserWidget* WidgetContextObject)
 {
 	if (WidgetContextObject)
@@ -71,6 +70,11 @@ UCommonActivatableWidget* UUIFunctionLibrary::PushContentToLayer_ForPlayer(const
 			{
 				return RootLayout->PushWidgetToLayerStack(LayerName, WidgetClass);
 			}
+
+			if (auto* HeadlessLayout{ Policy->GetHeadlessLayout(LocalPlayer) })
+			{
+				HeadlessLayout->Push(LayerName, FSoftObjectPath(WidgetClass.Get()));
+			}
 		}
 	}
 
@@ -94,6 +98,14 @@ void UUIFunctionLibrary::PushStreamedContentToLayer_ForPlayer(const ULocalPlayer
 
 				RootLayout->PushWidgetToLayerStackAsync(LayerName, bSuspendInputUntilComplete, WidgetClass);
 			}
+			else if (auto* HeadlessLayout{ Policy->GetHeadlessLayout(LocalPlayer) })
+			{
+				// The class is not streamed, the input is still suspended and resumed like an async push that completes right away
+
+				auto InputSuspension{ SuspendInputScopedForPlayer(LocalPlayer, TEXT("PushingWidgetToLayer")) };
+
+				HeadlessLayout->Push(LayerName, WidgetClass.ToSoftObjectPath());
+			}
 		}
 	}
 }
@@ -122,6 +134,81 @@ void UUIFunctionLibrary::PopContentFromLayer(UCommonActivatableWidget* Activatab
 	}
 }
 
+bool UUIFunctionLibrary::PopContentFromLayer_ForPlayer(const ULocalPlayer* LocalPlayer, FGameplayTag LayerName, TSoftClassPtr<UCommonActivatableWidget> WidgetClass)
+{
+	if (!ensure(LocalPlayer))
+	{
+		return false;
+	}
+
+	if (auto* UIManager{ LocalPlayer->GetGameInstance()->GetSubsystem<UUIManagerSubsystem>() })
+	{
+		if (auto* Policy{ UIManager->GetCurrentUIPolicy() })
+		{
+			if (auto* RootLayout{ Policy->GetRootLayout(LocalPlayer) })
+			{
+				if (auto* Layer{ RootLayout->GetLayerWidget(LayerName) })
+				{
+					const auto WidgetClassPath{ WidgetClass.ToSoftObjectPath() };
+					const auto& Widgets{ Layer->GetWidgetList() };
+
+					for (auto Index{ Widgets.Num() - 1 }; Index >= 0; --Index)
+					{
+						if (WidgetClass.IsNull() || (FSoftObjectPath(Widgets[Index]->GetClass()) == WidgetClassPath))
+						{
+							RootLayout->FindAndRemoveWidgetFromLayer(Widgets[Index]);
+							return true;
+						}
+					}
+				}
+			}
+			else if (auto* HeadlessLayout{ Policy->GetHeadlessLayout(LocalPlayer) })
+			{
+				return WidgetClass.IsNull() ? HeadlessLayout->Pop(LayerName) : HeadlessLayout->Remove(LayerName, WidgetClass.ToSoftObjectPath());
+			}
+		}
+	}
+
+	return false;
+}
+
+void UUIFunctionLibrary::ClearLayer_ForPlayer(const ULocalPlayer* LocalPlayer, FGameplayTag LayerName)
+{
+	if (!ensure(LocalPlayer))
+	{
+		return;
+	}
+
+	if (auto* UIManager{ LocalPlayer->GetGameInstance()->GetSubsystem<UUIManagerSubsystem>() })
+	{
+		if (auto* Policy{ UIManager->GetCurrentUIPolicy() })
+		{
+			if (auto* RootLayout{ Policy->GetRootLayout(LocalPlayer) })
+			{
+				// Forget the evicted entries first, so that the emptied layer does not restore them
+
+				RootLayout->ClearEvictedEntries(LayerName);
+
+				if (auto* Layer{ RootLayout->GetLayerWidget(LayerName) })
+				{
+					// Removed from the top one by one so that the layout keeps its own bookkeeping for each widget
+
+					auto Widgets{ Layer->GetWidgetList() };
+
+					for (auto Index{ Widgets.Num() - 1 }; Index >= 0; --Index)
+					{
+						RootLayout->FindAndRemoveWidgetFromLayer(Widgets[Index]);
+					}
+				}
+			}
+			else if (auto* HeadlessLayout{ Policy->GetHeadlessLayout(LocalPlayer) })
+			{
+				HeadlessLayout->ClearLayer(LayerName);
+			}
+		}
+	}
+}
+
 ULocalPlayer* UUIFunctionLibrary::GetLocalPlayerFromController(APlayerController* PlayerController)
 {
 	if (PlayerController)
@@ -139,20 +226,27 @@ FName UUIFunctionLibrary::SuspendInputForPlayer(APlayerController* PlayerControl
 
 FName UUIFunctionLibrary::SuspendInputForPlayer(ULocalPlayer* LocalPlayer, FName SuspendReason)
 {
-	if (auto* CommonInputSubsystem{ UCommonInputSubsystem::Get(LocalPlayer) })
+	if (auto* SuspensionSubsystem{ UUIInputSuspensionSubsystem::Get(LocalPlayer) })
 	{
-		InputSuspensions++;
-		auto SuspendToken{ SuspendReason };
-		SuspendToken.SetNumber(InputSuspensions);
+		return SuspensionSubsystem->SuspendInput(SuspendReason);
+	}
 
-		CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::MouseAndKeyboard, SuspendToken, true);
-		CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::Gamepad, SuspendToken, true);
-		CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::Touch, SuspendToken, true);
+	return NAME_None;
+}
+
+FUIInputSuspensionHandle UUIFunctionLibrary::SuspendInputScopedForPlayer(APlayerController* PlayerController, FName SuspendReason)
+{
+	return SuspendInputScopedForPlayer(PlayerController ? PlayerController->GetLocalPlayer() : nullptr, SuspendReason);
+}
 
-		return SuspendToken;
+FUIInputSuspensionHandle UUIFunctionLibrary::SuspendInputScopedForPlayer(const ULocalPlayer* LocalPlayer, FName SuspendReason)
+{
+	if (auto* SuspensionSubsystem{ UUIInputSuspensionSubsystem::Get(LocalPlayer) })
+	{
+		return SuspensionSubsystem->SuspendInputScoped(SuspendReason);
 	}
 
-	return NAME_None;
+	return FUIInputSuspensionHandle();
 }
 
 void UUIFunctionLibrary::ResumeInputForPlayer(APlayerController* PlayerController, FName SuspendToken)
@@ -167,10 +261,8 @@ void UUIFunctionLibrary::ResumeInputForPlayer(ULocalPlayer* LocalPlayer, FName S
 		return;
 	}
 
-	if (UCommonInputSubsystem* CommonInputSubsystem = UCommonInputSubsystem::Get(LocalPlayer))
+	if (auto* SuspensionSubsystem{ UUIInputSuspensionSubsystem::Get(LocalPlayer) })
 	{
-		CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::MouseAndKeyboard, SuspendToken, false);
-		CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::Gamepad, SuspendToken, false);
-		CommonInputSubsystem->SetInputTypeFilter(ECommonInputType::Touch, SuspendToken, false);
+		SuspensionSubsystem->ResumeInput(SuspendToken);
 	}
 }
@@ -4,6 +4,8 @@
 
 #include "Kismet/BlueprintFunctionLibrary.h"
 
+#include "Input/UIInputSuspensionSubsystem.h"
+
 #include "CommonInputTypeEnum.h"
 #include "GameplayTagContainer.h"
 
@@ -19,9 +21,6 @@ UCLASS()
 class GUIEXT_API UUIFunctionLibrary : public UBlueprintFunctionLibrary
 {
 	GENERATED_BODY()
-
-	static int32 InputSuspensions;
-
 public:
 	UUIFunctionLibrary() {}
 	
@@ -44,6 +43,21 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "UI Function")
 	static void PopContentFromLayer(UCommonActivatableWidget* ActivatableWidget);
 
+	/**
+	 * Removes the topmost content of the widget class from the layer, or the top content of the layer if no class is given.
+	 * 
+	 * Tips:
+	 *	Also works when the UI runs headless, where no widget instance exists to pass to PopContentFromLayer.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "UI Function", meta = (GameplayTagFilter = "UI.Layer"))
+	static bool PopContentFromLayer_ForPlayer(const ULocalPlayer* LocalPlayer, FGameplayTag LayerName, TSoftClassPtr<UCommonActivatableWidget> WidgetClass);
+
+	/**
+	 * Removes all content from the layer, in the root layout or in the headless layout of the player
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "UI Function", meta = (GameplayTagFilter = "UI.Layer"))
+	static void ClearLayer_ForPlayer(const ULocalPlayer* LocalPlayer, FGameplayTag LayerName);
+
 	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "UI Function")
 	static ULocalPlayer* GetLocalPlayerFromController(APlayerController* PlayerController);
 
@@ -55,4 +69,10 @@ public:
 	static void ResumeInputForPlayer(APlayerController* PlayerController, FName SuspendToken);
 	static void ResumeInputForPlayer(ULocalPlayer* LocalPlayer, FName SuspendToken);
 
+	/**
+	 * Suspends the input of the player until the returned handle is reset or destroyed
+	 */
+	static FUIInputSuspensionHandle SuspendInputScopedForPlayer(APlayerController* PlayerController, FName SuspendReason);
+	static FUIInputSuspensionHandle SuspendInputScopedForPlayer(const ULocalPlayer* LocalPlayer, FName SuspendReason);
+
 };
@@ -4,12 +4,23 @@
 
 #include "UIManagerSubsystem.h"
 #include "UIPolicy.h"
+#include "UIDeveloperSettings.h"
+#include "Foundation/ActivatableWidget.h"
+#include "Foundation/UIPlayerContextReceiver.h"
 #include "GUIExtLogs.h"
 
 #include "Player/GFCLocalPlayer.h"
 
+#include "Blueprint/GameViewportSubsystem.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/DynamicEntryBoxBase.h"
 #include "Engine/GameInstance.h"
+#include "Components/InvalidationBox.h"
+#include "Components/RetainerBox.h"
 #include "Kismet/GameplayStatics.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
 #include "Widgets/CommonActivatableWidgetContainer.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UILayout)
@@ -23,18 +34,22 @@ UUILayout::UUILayout(const FObjectInitializer& ObjectInitializer)
 
 void UUILayout::OnIsDormantChanged()
 {
-	//@TODO NDarnell Determine what to do with dormancy, in the past we treated dormancy as a way to shutoff rendering
-	//and the view for the other local players when we force multiple players to use the player view of a single player.
+	if (bIsDormant)
+	{
+		VisibilityBeforeDormancy = GetVisibility();
+
+		SetVisibility(ESlateVisibility::Collapsed);
+	}
+	else
+	{
+		SetVisibility(VisibilityBeforeDormancy);
+	}
 
-	//if (UCommonLocalPlayer* LocalPlayer = GetOwningLocalPlayer<UCommonLocalPlayer>())
-	//{
-	//	// When the root layout is dormant, we don't want to render anything from the owner's view either
-	//	LocalPlayer->SetIsPlayerViewEnabled(!bIsDormant);
-	//}
+	BP_OnDormancyChanged(bIsDormant);
 
-	//SetVisibility(bIsDormant ? ESlateVisibility::Collapsed : ESlateVisibility::SelfHitTestInvisible);
+	// Listeners such as the policy can shut off anything else owned by the player, like its view.
 
-	//OnLayoutDormancyChanged().Broadcast(bIsDormant);
+	LayoutDormancyChangedDelegate.Broadcast(bIsDormant);
 }
 
 void UUILayout::SetIsDormant(bool InDormant)
@@ -55,7 +70,69 @@ void UUILayout::SetIsDormant(bool InDormant)
 }
 
 
-void UUILayout::RegisterLayer(FGameplayTag LayerTag, UCommonActivatableWidgetContainerBase* LayerWidget)
+void UUILayout::SetPersistAcrossWorldChange(bool bPersist)
+{
+	bPersistAcrossWorldChange = bPersist;
+
+	ApplyPersistenceToViewportSlot();
+}
+
+void UUILayout::ApplyPersistenceToViewportSlot()
+{
+	// A persistent layout is rebound to the next world by the policy, which adds it again if it was removed anyway
+
+	auto* ViewportSubsystem{ UGameViewportSubsystem::Get(GetWorld()) };
+
+	if (ViewportSubsystem && ViewportSubsystem->IsWidgetAdded(this))
+	{
+		auto Slot{ ViewportSubsystem->GetWidgetSlot(this) };
+
+		if (Slot.bAutoRemoveOnWorldRemoved == bPersistAcrossWorldChange)
+		{
+			Slot.bAutoRemoveOnWorldRemoved = !bPersistAcrossWorldChange;
+			ViewportSubsystem->SetWidgetSlot(this, Slot);
+		}
+	}
+}
+
+void UUILayout::CullLayersForTravel(const FGameplayTagContainer& PersistentLayers)
+{
+	for (const auto& KVP : Layers)
+	{
+		if (PersistentLayers.HasTagExact(KVP.Key))
+		{
+			continue;
+		}
+
+		UE_LOG(LogGameExt_UI, Verbose, TEXT("[%s] culls layer [%s] for travel"), *GetNameSafe(this), *KVP.Key.ToString());
+
+		// Forget the evicted entries first, so that the emptied layer does not restore them
+
+		ClearEvictedEntries(KVP.Key);
+
+		if (auto* Layer{ KVP.Value.Get() })
+		{
+			for (auto* Widget : Layer->GetWidgetList())
+			{
+				RemoveWidgetFromLayerIndex(Widget, KVP.Key);
+			}
+
+			Layer->ClearWidgets();
+		}
+
+		DisplayedLayerWidgets.Remove(KVP.Key);
+	}
+
+	WarmInstances.RemoveAll(
+		[&PersistentLayers](const FUIWarmWidgetInstance& Entry)
+		{
+			return !PersistentLayers.HasTagExact(Entry.LayerTag);
+		}
+	);
+}
+
+
+void UUILayout::RegisterLayer(FGameplayTag LayerTag, UCommonActivatableWidgetContainerBase* LayerWidget, const FUILayerRenderSettings& RenderSettings)
 {
 	if (!IsDesignTime())
 	{
@@ -68,42 +145,820 @@ void UUILayout::RegisterLayer(FGameplayTag LayerTag, UCommonActivatableWidgetCon
 		LayerWidget->SetTransitionDuration(0.0);
 
 		Layers.Add(LayerTag, LayerWidget);
+		LayerOrder.AddUnique(LayerTag);
+
+		LayerWidget->OnDisplayedWidgetChanged().AddUObject(this, &ThisClass::HandleLayerDisplayedWidgetChanged, LayerTag);
+
+		SetupLayerRenderCache(LayerTag, LayerWidget, RenderSettings);
+	}
+}
+
+void UUILayout::SetupLayerRenderCache(FGameplayTag LayerTag, UCommonActivatableWidgetContainerBase* LayerWidget, const FUILayerRenderSettings& RenderSettings)
+{
+	if (RenderSettings.RenderMode == EUILayerRenderMode::Immediate)
+	{
+		return;
+	}
+
+	// Find the nearest caching panel between the layer and this layout
+
+	FUILayerRenderCache RenderCache;
+
+	for (auto* Parent{ LayerWidget->GetParent() }; Parent; Parent = Parent->GetParent())
+	{
+		if (RenderSettings.RenderMode == EUILayerRenderMode::Retained)
+		{
+			if (auto* RetainerBox{ Cast<URetainerBox>(Parent) })
+			{
+				RetainerBox->SetRetainRendering(true);
+				RetainerBox->SetRenderingPhase(0, FMath::Max(RenderSettings.RetainedFrameInterval, 1));
+
+				RenderCache.RetainerBox = RetainerBox;
+				break;
+			}
+		}
+		else if (auto* InvalidationBox{ Cast<UInvalidationBox>(Parent) })
+		{
+			InvalidationBox->SetCanCache(true);
+
+			RenderCache.InvalidationBox = InvalidationBox;
+			break;
+		}
+	}
+
+	if (!RenderCache.RetainerBox.IsValid() && !RenderCache.InvalidationBox.IsValid())
+	{
+		UE_LOG(LogGameExt_UI, Warning, TEXT("Layer [%s] of [%s] requested %s rendering but has no %s around it, it will be painted every frame"),
+			*LayerTag.ToString(), *GetNameSafe(this), *UEnum::GetValueAsString(RenderSettings.RenderMode),
+			(RenderSettings.RenderMode == EUILayerRenderMode::Retained) ? TEXT("Retainer Box") : TEXT("Invalidation Box"));
+		return;
+	}
+
+	LayerRenderCaches.Add(LayerTag, RenderCache);
+}
+
+void UUILayout::HandleLayerDisplayedWidgetChanged(UCommonActivatableWidget* DisplayedWidget, FGameplayTag LayerTag)
+{
+	InvalidateLayerRendering(LayerTag);
+
+	// Widgets below the displayed one stay deactivated on the layer, only the previously displayed one may have been popped
+
+	auto& LastDisplayedWidget{ DisplayedLayerWidgets.FindOrAdd(LayerTag) };
+	auto* PreviousWidget{ LastDisplayedWidget.Get() };
+
+	LastDisplayedWidget = DisplayedWidget;
+
+	if (PreviousWidget && (PreviousWidget != DisplayedWidget))
+	{
+		const auto* Layer{ GetLayerWidget(LayerTag) };
+
+		if (!Layer || !Layer->GetWidgetList().Contains(PreviousWidget))
+		{
+			RemoveWidgetFromLayerIndex(PreviousWidget, LayerTag);
+		}
+	}
+
+	UpdateLayerOcclusion();
+
+	// The layer has finished popping its last live entry, so the evicted entry below it can be pushed back
+
+	if (!DisplayedWidget && EvictedEntries.Contains(LayerTag))
+	{
+		RestoreEvictedLayerEntry(LayerTag);
+	}
+}
+
+void UUILayout::UpdateLayerOcclusion()
+{
+	auto bCovered{ false };
+
+	for (auto Index{ LayerOrder.Num() - 1 }; Index >= 0; --Index)
+	{
+		const auto& LayerTag{ LayerOrder[Index] };
+		auto* LayerWidget{ GetLayerWidget(LayerTag) };
+
+		if (!LayerWidget)
+		{
+			continue;
+		}
+
+		SetLayerCovered(LayerTag, LayerWidget, bCovered);
+
+		if (!bCovered)
+		{
+			const auto* DisplayedWidget{ Cast<UActivatableWidget>(LayerWidget->GetActiveWidget()) };
+
+			bCovered = DisplayedWidget && DisplayedWidget->IsActivated() && DisplayedWidget->IsFullscreenOpaque();
+		}
+	}
+}
+
+void UUILayout::SetLayerCovered(FGameplayTag LayerTag, UCommonActivatableWidgetContainerBase* LayerWidget, bool bCovered)
+{
+	// Collapsing the layer removes it from Slate's tick and paint, which also stops the animations of its widgets.
+
+	if (bCovered && !CoveredLayerVisibilities.Contains(LayerTag))
+	{
+		CoveredLayerVisibilities.Add(LayerTag, LayerWidget->GetVisibility());
+
+		LayerWidget->SetVisibility(ESlateVisibility::Collapsed);
+	}
+	else if (!bCovered && CoveredLayerVisibilities.Contains(LayerTag))
+	{
+		LayerWidget->SetVisibility(CoveredLayerVisibilities.FindAndRemoveChecked(LayerTag));
+	}
+
+	// Entries below the displayed one of a stack are covered as well
+
+	const auto* DisplayedWidget{ LayerWidget->GetActiveWidget() };
+
+	for (const auto& Widget : LayerWidget->GetWidgetList())
+	{
+		if (auto* ActivatableWidget{ Cast<UActivatableWidget>(Widget) })
+		{
+			ActivatableWidget->SetIsCovered(bCovered || (ActivatableWidget != DisplayedWidget));
+		}
+	}
+}
+
+void UUILayout::InvalidateLayerRendering(FGameplayTag LayerTag)
+{
+	if (const auto* RenderCache{ LayerRenderCaches.Find(LayerTag) })
+	{
+		if (auto* RetainerBox{ RenderCache->RetainerBox.Get() })
+		{
+			RetainerBox->RequestRender();
+		}
+
+		if (auto* InvalidationBox{ RenderCache->InvalidationBox.Get() })
+		{
+			InvalidationBox->InvalidateCache();
+		}
 	}
 }
 
 void UUILayout::OnWidgetStackTransitioning(UCommonActivatableWidgetContainerBase* Widget, bool bIsTransitioning)
 {
+	static const auto NAME_GlobalStackTransition{ FName(TEXT("GlobalStackTransition")) };
+
 	if (bIsTransitioning)
 	{
-		const auto SuspendToken{ UUIFunctionLibrary::SuspendInputForPlayer(GetOwningLocalPlayer(), TEXT("GlobalStackTransion")) };
-		SuspendInputTokens.Add(SuspendToken);
+		StackTransitionSuspensions.Add(UUIFunctionLibrary::SuspendInputScopedForPlayer(GetOwningLocalPlayer(), NAME_GlobalStackTransition));
 	}
 	else
 	{
-		if (ensure(SuspendInputTokens.Num() > 0))
+		// Destroying the handle resumes the input
+
+		if (ensure(StackTransitionSuspensions.Num() > 0))
+		{
+			StackTransitionSuspensions.Pop();
+		}
+	}
+}
+
+
+void UUILayout::NotifyWidgetPushedToLayer(UCommonActivatableWidget* ActivatableWidget, FGameplayTag LayerName)
+{
+	RegisterWidgetOnLayer(ActivatableWidget, LayerName);
+
+	InvalidateLayerRendering(LayerName);
+
+	UpdateLayerOcclusion();
+
+	EvictLayerEntriesOverBudget(LayerName);
+
+	if (ActivatableWidget)
+	{
+		if (auto* LocalPlayer{ GetOwningLocalPlayer() })
+		{
+			if (auto* UIManager{ LocalPlayer->GetGameInstance()->GetSubsystem<UUIManagerSubsystem>() })
+			{
+				UIManager->NotifyWidgetClassUsed(LocalPlayer, LayerName, ActivatableWidget->GetClass());
+			}
+		}
+	}
+}
+
+void UUILayout::RegisterWidgetOnLayer(UCommonActivatableWidget* ActivatableWidget, FGameplayTag LayerName)
+{
+	if (ActivatableWidget)
+	{
+		WidgetLayerIndex.Add(ActivatableWidget, LayerName);
+	}
+}
+
+void UUILayout::RemoveWidgetFromLayerIndex(UCommonActivatableWidget* ActivatableWidget, FGameplayTag LayerName)
+{
+	// Pooled instances may have been pushed to another layer since
+
+	if (ActivatableWidget && (WidgetLayerIndex.FindRef(ActivatableWidget) == LayerName))
+	{
+		WidgetLayerIndex.Remove(ActivatableWidget);
+	}
+}
+
+
+UCommonActivatableWidget* UUILayout::AcquireWarmInstance(FGameplayTag LayerName, UClass* ActivatableWidgetClass, UCommonActivatableWidgetContainerBase* Layer)
+{
+	const auto* Rule{ FindWarmCacheRule(LayerName, ActivatableWidgetClass) };
+
+	if (!Rule || !Layer)
+	{
+		return nullptr;
+	}
+
+	auto NumInstances{ 0 };
+
+	for (const auto& Entry : WarmInstances)
+	{
+		auto* Widget{ Entry.Widget.Get() };
+
+		if (Widget && (Entry.LayerTag == LayerName) && (Widget->GetClass() == ActivatableWidgetClass))
+		{
+			++NumInstances;
+
+			// Only reuse instances that have been deactivated and released by the layer.
+
+			if (!Widget->IsActivated() && !Layer->GetWidgetList().Contains(Widget))
+			{
+				UE_LOG(LogGameExt_UI, Verbose, TEXT("[%s] reuses warm instance [%s] for [%s]"), *GetNameSafe(this), *GetNameSafe(Widget), *LayerName.ToString());
+
+				if (auto* GUIExtWidget{ Cast<UActivatableWidget>(Widget) })
+				{
+					GUIExtWidget->NativeOnWarmReuse();
+				}
+
+				return Widget;
+			}
+		}
+	}
+
+	if (NumInstances < Rule->MaxInstances)
+	{
+		auto* NewWidget{ CreateWidget<UCommonActivatableWidget>(Layer, ActivatableWidgetClass) };
+
+		WarmInstances.Emplace(NewWidget, NewWidget->TakeWidget(), LayerName);
+
+		return NewWidget;
+	}
+
+	return nullptr;
+}
+
+const FUIWarmWidgetCacheRule* UUILayout::FindWarmCacheRule(FGameplayTag LayerName, UClass* ActivatableWidgetClass) const
+{
+	if (WarmCacheRules.IsEmpty() || !ActivatableWidgetClass)
+	{
+		return nullptr;
+	}
+
+	const auto ClassPath{ FSoftObjectPath(ActivatableWidgetClass) };
+
+	return WarmCacheRules.FindByPredicate(
+		[&LayerName, &ClassPath](const FUIWarmWidgetCacheRule& Rule)
+		{
+			return (Rule.LayerTag == LayerName) && (Rule.WidgetClass.ToSoftObjectPath() == ClassPath);
+		}
+	);
+}
+
+void UUILayout::CreateWarmInstances(const FUIWarmWidgetCacheRule& Rule)
+{
+	auto* Layer{ GetLayerWidget(Rule.LayerTag) };
+	auto* WidgetClass{ Rule.WidgetClass.Get() };
+
+	if (!Layer || !WidgetClass)
+	{
+		return;
+	}
+
+	auto NumInstances
+	{
+		WarmInstances.FilterByPredicate(
+			[&Rule, WidgetClass](const FUIWarmWidgetInstance& Entry)
+			{
+				return Entry.Widget && (Entry.LayerTag == Rule.LayerTag) && (Entry.Widget->GetClass() == WidgetClass);
+			}
+		).Num()
+	};
+
+	for (; NumInstances < Rule.MaxInstances; ++NumInstances)
+	{
+		UE_LOG(LogGameExt_UI, Verbose, TEXT("[%s] pre-warms an instance of [%s] for [%s]"), *GetNameSafe(this), *GetNameSafe(WidgetClass), *Rule.LayerTag.ToString());
+
+		auto* NewWidget{ CreateWidget<UCommonActivatableWidget>(Layer, WidgetClass) };
+
+		WarmInstances.Emplace(NewWidget, NewWidget->TakeWidget(), Rule.LayerTag);
+	}
+}
+
+void UUILayout::HandlePreWarmClassLoaded(int32 RuleIndex)
+{
+	if (WarmCacheRules.IsValidIndex(RuleIndex))
+	{
+		CreateWarmInstances(WarmCacheRules[RuleIndex]);
+	}
+}
+
+void UUILayout::PreWarmLayerContent()
+{
+	for (auto Index{ 0 }; Index < WarmCacheRules.Num(); ++Index)
+	{
+		const auto& Rule{ WarmCacheRules[Index] };
+
+		if (Rule.WidgetClass.IsNull())
+		{
+			continue;
+		}
+
+		if (Rule.WidgetClass.Get())
+		{
+			CreateWarmInstances(Rule);
+		}
+		else
+		{
+			PreWarmLoadRequests.Add(
+				FUIAsyncLoadRegistry::Get().RequestAsyncLoad(
+					Rule.WidgetClass.ToSoftObjectPath(),
+					FStreamableDelegate::CreateUObject(this, &ThisClass::HandlePreWarmClassLoaded, Index),
+					FStreamableDelegate(),
+					GetLayerLoadPriority(Rule.LayerTag),
+					Rule.LayerTag.GetTagName()
+				)
+			);
+		}
+	}
+}
+
+void UUILayout::FlushWarmCache()
+{
+	for (const auto& LoadRequest : PreWarmLoadRequests)
+	{
+		if (LoadRequest.IsValid())
 		{
-			const auto SuspendToken{ SuspendInputTokens.Pop() };
-			UUIFunctionLibrary::ResumeInputForPlayer(GetOwningLocalPlayer(), SuspendToken);
+			LoadRequest->Cancel();
 		}
 	}
+
+	PreWarmLoadRequests.Reset();
+	WarmInstances.Reset();
+}
+
+
+void UUILayout::EvictLayerEntriesOverBudget(FGameplayTag LayerName)
+{
+	const auto Budget{ LayerLiveEntryBudgets.FindRef(LayerName) };
+	auto* Stack{ Cast<UCommonActivatableWidgetStack>(GetLayerWidget(LayerName)) };
+
+	if ((Budget <= 0) || !Stack || bRestoringEvictedEntry)
+	{
+		return;
+	}
+
+	// The widget list of a stack is ordered from the bottom to the top
+
+	while (Stack->GetNumWidgets() > Budget)
+	{
+		auto* OldestWidget{ Stack->GetWidgetList()[0] };
+
+		if (!OldestWidget || OldestWidget->IsActivated())
+		{
+			break;
+		}
+
+		// Entries evicted later were above the ones evicted before, so they are restored first
+
+		FUIEvictedWidgetEntry EvictedEntry;
+		EvictedEntry.WidgetClass = OldestWidget->GetClass();
+
+		{
+			FMemoryWriter Writer(EvictedEntry.SavedState);
+			FObjectAndNameAsStringProxyArchive Archive(Writer, true);
+			Archive.ArIsSaveGame = true;
+			OldestWidget->Serialize(Archive);
+		}
+
+		UE_LOG(LogGameExt_UI, Verbose, TEXT("[%s] evicted [%s] from [%s] (%d bytes of saved state)"),
+			*GetNameSafe(this), *GetNameSafe(OldestWidget), *LayerName.ToString(), EvictedEntry.SavedState.Num());
+
+		EvictedEntries.FindOrAdd(LayerName).Entries.Add(MoveTemp(EvictedEntry));
+
+		WidgetLayerIndex.Remove(OldestWidget);
+
+		Stack->RemoveWidget(*OldestWidget);
+	}
+}
+
+void UUILayout::RestoreEvictedLayerEntry(FGameplayTag LayerName)
+{
+	auto* EvictedStack{ EvictedEntries.Find(LayerName) };
+	auto* Layer{ GetLayerWidget(LayerName) };
+
+	// Only restore once the layer has no live entry left, otherwise the entry below is displayed next
+
+	if (!EvictedStack || !Layer || (Layer->GetNumWidgets() > 0))
+	{
+		return;
+	}
+
+	auto EvictedEntry{ EvictedStack->Entries.Pop() };
+
+	if (EvictedStack->Entries.IsEmpty())
+	{
+		EvictedEntries.Remove(LayerName);
+	}
+
+	if (!EvictedEntry.WidgetClass)
+	{
+		return;
+	}
+
+	TGuardValue<bool> RestoringGuard(bRestoringEvictedEntry, true);
+
+	PushWidgetToLayerStack<UCommonActivatableWidget>(LayerName, EvictedEntry.WidgetClass,
+		[&EvictedEntry](UCommonActivatableWidget& Widget)
+		{
+			FMemoryReader Reader(EvictedEntry.SavedState);
+			FObjectAndNameAsStringProxyArchive Archive(Reader, true);
+			Archive.ArIsSaveGame = true;
+			Widget.Serialize(Archive);
+
+			if (auto* ActivatableWidget{ Cast<UActivatableWidget>(&Widget) })
+			{
+				ActivatableWidget->NativeOnRestoredFromEviction();
+			}
+		}
+	);
+}
+
+void UUILayout::ClearEvictedEntries(FGameplayTag LayerName)
+{
+	EvictedEntries.Remove(LayerName);
 }
 
 
 void UUILayout::FindAndRemoveWidgetFromLayer(UCommonActivatableWidget* ActivatableWidget)
 {
+	// If the widget was pushed through this layout we already know its layer.
+
+	if (const auto* LayerTagPtr{ WidgetLayerIndex.Find(ActivatableWidget) })
+	{
+		const auto LayerTag{ *LayerTagPtr };
+
+		WidgetLayerIndex.Remove(ActivatableWidget);
+
+		if (auto* Layer{ GetLayerWidget(LayerTag) })
+		{
+			Layer->RemoveWidget(*ActivatableWidget);
+
+			InvalidateLayerRendering(LayerTag);
+			return;
+		}
+	}
+
 	// We're not sure what layer the widget is on so go searching.
 
 	for (const auto& KVP : Layers)
 	{
 		KVP.Value->RemoveWidget(*ActivatableWidget);
+
+		InvalidateLayerRendering(KVP.Key);
 	}
 }
 
+FGameplayTag UUILayout::GetLayerForWidget(const UCommonActivatableWidget* ActivatableWidget) const
+{
+	return WidgetLayerIndex.FindRef(ActivatableWidget);
+}
+
 UCommonActivatableWidgetContainerBase* UUILayout::GetLayerWidget(FGameplayTag LayerName)
 {
 	return Layers.FindRef(LayerName);
 }
 
+TSharedPtr<FUIAsyncLoadRequest> UUILayout::PushWidgetToLayerStackAsyncInternal(FGameplayTag LayerName, bool bSuspendInputUntilComplete, TSoftClassPtr<UCommonActivatableWidget> ActivatableWidgetClass, TFunction<void(EAsyncWidgetLayerState, UCommonActivatableWidget*)> StateFunc)
+{
+	// If the class is already loaded (prefetched or pushed before) there is nothing to wait for.
+
+	if (auto* LoadedClass{ ActivatableWidgetClass.Get() })
+	{
+		// Classes loaded for other reasons are not credited to the prefetch
+
+		if (PrefetchedPaths.Contains(ActivatableWidgetClass.ToSoftObjectPath()))
+		{
+			PrefetchStats.Hits++;
+		}
+
+		UE_LOG(LogGameExt_UI, Verbose, TEXT("[%s] pushes [%s] to [%s] from a loaded class (Hits: %d, Misses: %d)"), 
+			*GetNameSafe(this), *GetNameSafe(LoadedClass), *LayerName.ToString(), PrefetchStats.Hits, PrefetchStats.Misses);
+
+		auto* Widget
+		{
+			PushWidgetToLayerStack<UCommonActivatableWidget>(
+				LayerName, LoadedClass, [&StateFunc](UCommonActivatableWidget& WidgetToInit)
+				{
+					StateFunc(EAsyncWidgetLayerState::Initialize, &WidgetToInit);
+				}
+			)
+		};
+
+		StateFunc(EAsyncWidgetLayerState::AfterPush, Widget);
+
+		// Callers may still wait on or cancel the returned request, so hand them one that has already completed
+
+		return FUIAsyncLoadRegistry::Get().MakeCompletedRequest(ActivatableWidgetClass.ToSoftObjectPath());
+	}
+
+	PrefetchStats.Misses++;
+
+	UE_LOG(LogGameExt_UI, Verbose, TEXT("[%s] has to load [%s] before pushing it to [%s] (Hits: %d, Misses: %d)"),
+		*GetNameSafe(this), *ActivatableWidgetClass.ToString(), *LayerName.ToString(), PrefetchStats.Hits, PrefetchStats.Misses);
+
+	const auto ClassPath{ ActivatableWidgetClass.ToSoftObjectPath() };
+	const auto PendingKey{ MakeTuple(LayerName, ClassPath) };
+	const auto bCollapseDuplicates{ GetDefault<UUIDeveloperSettings>()->bCollapseDuplicateLayerPushes };
+
+	// A duplicate push joins the pending one so it does not push a second instance.
+	// Each waiter still holds its own suspension, so canceling one of them leaves input suspended for the others.
+
+	if (bCollapseDuplicates)
+	{
+		PendingLayerPushes.FindOrAdd(PendingKey).NumWaiters++;
+	}
+
+	// Shared by the complete and cancel delegates, the input also resumes if both are dropped without running
+
+	static const auto NAME_PushingWidgetToLayer{ FName(TEXT("PushingWidgetToLayer")) };
+	const auto InputSuspension{ MakeShared<FUIInputSuspensionHandle>() };
+
+	if (bSuspendInputUntilComplete)
+	{
+		*InputSuspension = UUIFunctionLibrary::SuspendInputScopedForPlayer(GetOwningPlayer(), NAME_PushingWidgetToLayer);
+	}
+
+	return FUIAsyncLoadRegistry::Get().RequestAsyncLoad(
+		ClassPath,
+		FStreamableDelegate::CreateWeakLambda(
+			this, [this, LayerName, ActivatableWidgetClass, StateFunc, InputSuspension, PendingKey, bCollapseDuplicates]()
+			{
+				InputSuspension->Reset();
+
+				auto* PendingPush{ bCollapseDuplicates ? PendingLayerPushes.Find(PendingKey) : nullptr };
+				auto* Widget{ PendingPush ? PendingPush->PushedWidget.Get() : nullptr };
+
+				if (!Widget)
+				{
+					Widget = PushWidgetToLayerStack<UCommonActivatableWidget>(
+						LayerName, ActivatableWidgetClass.Get(), [&StateFunc](UCommonActivatableWidget& WidgetToInit)
+						{
+							StateFunc(EAsyncWidgetLayerState::Initialize, &WidgetToInit);
+						}
+					);
+
+					if (PendingPush)
+					{
+						PendingPush->PushedWidget = Widget;
+					}
+				}
+
+				if (bCollapseDuplicates)
+				{
+					ReleasePendingLayerPush(PendingKey);
+				}
+
+				StateFunc(EAsyncWidgetLayerState::AfterPush, Widget);
+			}
+		),
+
+		// Resume input if the request is canceled.
+
+		FStreamableDelegate::CreateWeakLambda(
+			this, [this, StateFunc, InputSuspension, PendingKey, bCollapseDuplicates]()
+			{
+				InputSuspension->Reset();
+
+				if (bCollapseDuplicates)
+				{
+					ReleasePendingLayerPush(PendingKey);
+				}
+
+				StateFunc(EAsyncWidgetLayerState::Canceled, nullptr);
+			}
+		),
+		GetLayerLoadPriority(LayerName),
+		LayerName.GetTagName()
+	);
+}
+
+void UUILayout::ReleasePendingLayerPush(const TTuple<FGameplayTag, FSoftObjectPath>& Key)
+{
+	if (auto* PendingPush{ PendingLayerPushes.Find(Key) })
+	{
+		if (--PendingPush->NumWaiters <= 0)
+		{
+			PendingLayerPushes.Remove(Key);
+		}
+	}
+}
+
+
+int32 UUILayout::GetLayerLoadPriority(FGameplayTag LayerName) const
+{
+	const auto& LayerLoadPriorities{ GetDefault<UUIDeveloperSettings>()->LayerLoadPriorities };
+
+	// Walk up the tag hierarchy until a layer with a priority is found
+
+	for (auto Tag{ LayerName }; Tag.IsValid(); Tag = Tag.RequestDirectParent())
+	{
+		if (const auto* Priority{ LayerLoadPriorities.Find(Tag) })
+		{
+			return *Priority;
+		}
+	}
+
+	return FStreamableManager::DefaultAsyncLoadPriority;
+}
+
+FUIAsyncLoadQueueStats UUILayout::GetLayerQueueStats(FGameplayTag LayerName) const
+{
+	return FUIAsyncLoadRegistry::Get().GetQueueStats(LayerName.GetTagName());
+}
+
+
+TSharedPtr<FUILayerPushSequence> UUILayout::PushWidgetSequenceToLayers(const TArray<FUILayerPushSequenceEntry>& Entries, bool bSuspendInputUntilComplete, FUILayerPushSequence::FStateFunc StateFunc)
+{
+	auto Sequence{ MakeShared<FUILayerPushSequence>(this, Entries, MoveTemp(StateFunc)) };
+
+	Sequence->Start(bSuspendInputUntilComplete);
+
+	return Sequence;
+}
+
+
+void UUILayout::GatherPrefetchEntries(TArray<FUILayerPrefetchEntry>& OutEntries) const
+{
+	OutEntries.Append(PrefetchEntries);
+}
+
+void UUILayout::StartPrefetch(const TArray<FUILayerPrefetchEntry>& AdditionalEntries)
+{
+	TArray<FUILayerPrefetchEntry> Entries;
+	GatherPrefetchEntries(Entries);
+	Entries.Append(AdditionalEntries);
+
+	Entries.StableSort(
+		[](const FUILayerPrefetchEntry& A, const FUILayerPrefetchEntry& B)
+		{
+			return A.Priority > B.Priority;
+		}
+	);
+
+	auto& StreamableManager{ UAssetManager::Get().GetStreamableManager() };
+
+	auto* UIManager{ GetGameInstance() ? GetGameInstance()->GetSubsystem<UUIManagerSubsystem>() : nullptr };
+	auto* Policy{ UIManager ? UIManager->GetCurrentUIPolicy() : nullptr };
+	const auto* LocalPlayer{ GetOwningLocalPlayer() };
+
+	for (const auto& Entry : Entries)
+	{
+		if (Entry.WidgetClass.IsNull())
+		{
+			continue;
+		}
+
+		UE_LOG(LogGameExt_UI, Verbose, TEXT("[%s] prefetches [%s] for [%s]"), *GetNameSafe(this), *Entry.WidgetClass.ToString(), *Entry.LayerTag.ToString());
+
+		const auto Priority{ FStreamableManager::DefaultAsyncLoadPriority + Entry.Priority };
+
+		PrefetchedPaths.Add(Entry.WidgetClass.ToSoftObjectPath());
+
+		if (Policy && LocalPlayer)
+		{
+			Policy->AcquireSharedWidgetClass(LocalPlayer, Entry.WidgetClass.ToSoftObjectPath(), Priority);
+
+			SharedPrefetchPaths.Add(Entry.WidgetClass.ToSoftObjectPath());
+			SharedPrefetchPlayer = LocalPlayer;
+			continue;
+		}
+
+		PrefetchHandles.Add(
+			StreamableManager.RequestAsyncLoad(
+				Entry.WidgetClass.ToSoftObjectPath(),
+				FStreamableDelegate(),
+				Priority
+			)
+		);
+	}
+}
+
+void UUILayout::ReleasePrefetch()
+{
+	for (const auto& Handle : PrefetchHandles)
+	{
+		if (Handle.IsValid())
+		{
+			Handle->ReleaseHandle();
+		}
+	}
+
+	PrefetchHandles.Reset();
+	PrefetchedPaths.Reset();
+
+	if (!SharedPrefetchPaths.IsEmpty())
+	{
+		auto* UIManager{ GetGameInstance() ? GetGameInstance()->GetSubsystem<UUIManagerSubsystem>() : nullptr };
+
+		if (auto* Policy{ UIManager ? UIManager->GetCurrentUIPolicy() : nullptr })
+		{
+			for (const auto& Path : SharedPrefetchPaths)
+			{
+				Policy->ReleaseSharedWidgetClass(SharedPrefetchPlayer.Get(), Path);
+			}
+		}
+
+		SharedPrefetchPaths.Reset();
+		SharedPrefetchPlayer.Reset();
+	}
+}
+
+
+void UUILayout::RebindPlayerController(APlayerController* PlayerController)
+{
+	auto* OldPlayerController{ GetOwningPlayer() };
+
+	// Layouts bound through the local player already resolve the new controller, but their widgets still need to move to it
+
+	if (!PlayerController)
+	{
+		return;
+	}
+
+	UE_LOG(LogGameExt_UI, Log, TEXT("[%s] rebinds from [%s] to [%s]"), *GetNameSafe(this), *GetNameSafe(OldPlayerController), *GetNameSafe(PlayerController));
+
+	const auto PlayerContext{ FLocalPlayerContext(PlayerController) };
+
+	RebindUserWidget(this, PlayerContext, OldPlayerController, PlayerController, true);
+
+	// Warm instances are off the layers, but are pushed again later
+
+	for (const auto& Entry : WarmInstances)
+	{
+		if (Entry.Widget && !Entry.Widget->IsActivated())
+		{
+			RebindUserWidget(Entry.Widget, PlayerContext, OldPlayerController, PlayerController, true);
+		}
+	}
+}
+
+void UUILayout::RebindUserWidget(UUserWidget* UserWidget, const FLocalPlayerContext& PlayerContext, APlayerController* OldPlayerController, APlayerController* NewPlayerController, bool bApplyContext)
+{
+	if (!UserWidget)
+	{
+		return;
+	}
+
+	// SetPlayerContext already covers the whole widget tree, only widgets created outside of it need it again
+
+	if (bApplyContext)
+	{
+		UserWidget->SetPlayerContext(PlayerContext);
+	}
+
+	if (auto* Receiver{ Cast<IUIPlayerContextReceiver>(UserWidget) })
+	{
+		Receiver->NativeOnPlayerControllerRebound(OldPlayerController, NewPlayerController);
+	}
+
+	if (!UserWidget->WidgetTree)
+	{
+		return;
+	}
+
+	UserWidget->WidgetTree->ForEachWidget(
+		[&](UWidget* Widget)
+		{
+			if (auto* ChildUserWidget{ Cast<UUserWidget>(Widget) })
+			{
+				RebindUserWidget(ChildUserWidget, PlayerContext, OldPlayerController, NewPlayerController, false);
+			}
+			else if (auto* EntryBox{ Cast<UDynamicEntryBoxBase>(Widget) })
+			{
+				for (auto* Entry : EntryBox->GetAllEntries())
+				{
+					RebindUserWidget(Entry, PlayerContext, OldPlayerController, NewPlayerController, true);
+				}
+			}
+			else if (auto* Layer{ Cast<UCommonActivatableWidgetContainerBase>(Widget) })
+			{
+				for (auto* LayerWidget : Layer->GetWidgetList())
+				{
+					RebindUserWidget(LayerWidget, PlayerContext, OldPlayerController, NewPlayerController, true);
+				}
+			}
+		}
+	);
+}
+
 
 UUILayout* UUILayout::GetUILayoutForPrimaryPlayer(const UObject* WorldContextObject)
 {
@@ -5,13 +5,19 @@
 #include "CommonUserWidget.h"
 
 #include "UIFunctionLibrary.h"
+#include "Loading/UIAsyncLoadRegistry.h"
+#include "Loading/UILayerPushSequence.h"
 
 #include "Engine/AssetManager.h"
 #include "Engine/StreamableManager.h"
+#include "UObject/ObjectKey.h"
 #include "Widgets/CommonActivatableWidgetContainer.h"
 
 #include "UILayout.generated.h"
 
+class UInvalidationBox;
+class URetainerBox;
+
 
 /**
  * The state of an async load operation for the UI.
@@ -26,6 +32,213 @@ enum class EAsyncWidgetLayerState : uint8
 };
 
 
+/**
+ * How a layer of the layout is painted
+ */
+UENUM(BlueprintType)
+enum class EUILayerRenderMode : uint8
+{
+	Immediate,		// Painted every frame
+
+	Invalidation,	// Cached by an Invalidation Box around the layer and repainted only when invalidated
+
+	Retained		// Rendered to a texture by a Retainer Box around the layer at a reduced rate
+};
+
+
+/**
+ * Rendering settings for a layer of the layout
+ *
+ * Tips:
+ *	Invalidation and Retained modes use the Invalidation Box or Retainer Box placed around the layer widget in the layout.
+ */
+USTRUCT(BlueprintType)
+struct FUILayerRenderSettings
+{
+	GENERATED_BODY()
+public:
+	FUILayerRenderSettings() {}
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EUILayerRenderMode RenderMode{ EUILayerRenderMode::Immediate };
+
+	//
+	// The retained layer is rendered once every this many frames, higher values trade freshness for paint time
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = 1, EditCondition = "RenderMode == EUILayerRenderMode::Retained"))
+	int32 RetainedFrameInterval{ 4 };
+
+};
+
+
+/**
+ * Widget class to load ahead of time for a layer of the layout
+ */
+USTRUCT(BlueprintType)
+struct FUILayerPrefetchEntry
+{
+	GENERATED_BODY()
+public:
+	FUILayerPrefetchEntry() {}
+
+public:
+	//
+	// The layer the widget is expected to be pushed to
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Categories = "UI.Layer"))
+	FGameplayTag LayerTag;
+
+	//
+	// The widget class to load
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	TSoftClassPtr<UCommonActivatableWidget> WidgetClass;
+
+	//
+	// Load priority of the class, higher values are requested first
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	int32 Priority{ 0 };
+
+};
+
+
+/**
+ * Counters showing whether async pushes were served from already loaded widget classes
+ */
+USTRUCT(BlueprintType)
+struct FUILayerPrefetchStats
+{
+	GENERATED_BODY()
+public:
+	FUILayerPrefetchStats() {}
+
+public:
+	//
+	// Number of async pushes whose class was prefetched and already loaded
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Hits{ 0 };
+
+	//
+	// Number of async pushes that had to wait for the class to load
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 Misses{ 0 };
+
+};
+
+
+/**
+ * Rule that keeps deactivated instances of a widget class alive so that the next push to the same layer can reuse them
+ */
+USTRUCT(BlueprintType)
+struct FUIWarmWidgetCacheRule
+{
+	GENERATED_BODY()
+public:
+	FUIWarmWidgetCacheRule() {}
+
+public:
+	//
+	// The layer the instances are pushed to
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (Categories = "UI.Layer"))
+	FGameplayTag LayerTag;
+
+	//
+	// The widget class to keep warm
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	TSoftClassPtr<UCommonActivatableWidget> WidgetClass;
+
+	//
+	// Maximum number of instances of this class kept for the layer
+	//
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (ClampMin = 1))
+	int32 MaxInstances{ 1 };
+
+};
+
+
+/**
+ * Widget instance owned by the warm cache of the layout
+ *
+ * Tips:
+ *	The Slate widget is held as well, because the layer releases it when the instance is popped and the widget only references it weakly.
+ */
+USTRUCT()
+struct FUIWarmWidgetInstance
+{
+	GENERATED_BODY()
+public:
+	FUIWarmWidgetInstance() {}
+
+	FUIWarmWidgetInstance(UCommonActivatableWidget* InWidget, TSharedPtr<SWidget> InSlateWidget, FGameplayTag InLayerTag)
+		: Widget(InWidget)
+		, SlateWidget(MoveTemp(InSlateWidget))
+		, LayerTag(InLayerTag)
+	{}
+
+public:
+	UPROPERTY(Transient)
+	TObjectPtr<UCommonActivatableWidget> Widget{ nullptr };
+
+	TSharedPtr<SWidget> SlateWidget;
+
+	UPROPERTY(Transient)
+	FGameplayTag LayerTag;
+
+};
+
+
+/**
+ * Stack entry released by the eviction budget of the layout, restored from its class and saved state
+ */
+USTRUCT()
+struct FUIEvictedWidgetEntry
+{
+	GENERATED_BODY()
+public:
+	FUIEvictedWidgetEntry() {}
+
+public:
+	UPROPERTY(Transient)
+	TSubclassOf<UCommonActivatableWidget> WidgetClass{ nullptr };
+
+	//
+	// The SaveGame properties of the instance at the time it was evicted
+	//
+	UPROPERTY(Transient)
+	TArray<uint8> SavedState;
+
+};
+
+
+/**
+ * Entries evicted from a layer, the last one was the closest to the live entries
+ */
+USTRUCT()
+struct FUIEvictedWidgetStack
+{
+	GENERATED_BODY()
+public:
+	FUIEvictedWidgetStack() {}
+
+public:
+	UPROPERTY(Transient)
+	TArray<FUIEvictedWidgetEntry> Entries;
+
+};
+
+
+/**
+ * Delegate notifying that the dormancy of the layout has changed
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FUILayoutDormancyChangedDelegate, bool /*bIsDormant*/);
+
+
 /**
  * The primary game UI layout of your game.  This widget class represents how to layout, push and display all layers
  * of the UI for a single player.  Each player in a split-screen game will receive their own primary game layout.
@@ -40,9 +253,25 @@ public:
 private:
 	bool bIsDormant{ false };
 
+	//
+	// Visibility of the layout before it became dormant, restored when it wakes up
+	//
+	ESlateVisibility VisibilityBeforeDormancy{ ESlateVisibility::SelfHitTestInvisible };
+
+	FUILayoutDormancyChangedDelegate LayoutDormancyChangedDelegate;
+
 protected:
+	/**
+	 * Collapses the layout while it is dormant and restores it on wake
+	 * 
+	 * Tips:
+	 *	A collapsed layout is skipped by Slate's prepass, tick and paint, so the widgets of its layers stop ticking and animating.
+	 */
 	virtual void OnIsDormantChanged();
 
+	UFUNCTION(BlueprintImplementableEvent, Category = "Dormancy", meta = (DisplayName = "On Dormancy Changed"))
+	void BP_OnDormancyChanged(bool bNewIsDormant);
+
 public:
 	/** 
 	 * A dormant root layout is collapsed and responds only to persistent actions registered by the owning player 
@@ -54,13 +283,43 @@ public:
 	 */
 	bool IsDormant() const { return bIsDormant; }
 
+	FUILayoutDormancyChangedDelegate& OnLayoutDormancyChanged() { return LayoutDormancyChangedDelegate; }
+
+
+private:
+	//
+	// If true, the layout stays in the viewport when the world it was added in is torn down
+	//
+	bool bPersistAcrossWorldChange{ false };
+
+public:
+	/**
+	 * Keeps the layout in the viewport across the next world change, used while seamless travelling
+	 * 
+	 * Tips:
+	 *	The viewport subsystem removes viewport widgets with their world, this clears bAutoRemoveOnWorldRemoved on the slot of the layout.
+	 *	If the layout is not in the viewport yet, call ApplyPersistenceToViewportSlot once it has been added.
+	 */
+	void SetPersistAcrossWorldChange(bool bPersist);
+
+	void ApplyPersistenceToViewportSlot();
+
+	bool PersistsAcrossWorldChange() const { return bPersistAcrossWorldChange; }
+
+	/**
+	 * Clears every layer that is not in the container, together with its evicted entries and warm instances
+	 * 
+	 * Tips:
+	 *	Content of the kept layers must not hold on to actors of the old world, it is notified through IUIPlayerContextReceiver once the layout is rebound.
+	 */
+	void CullLayersForTravel(const FGameplayTagContainer& PersistentLayers);
+
 
 private:
 	//
-	// Lets us keep track of all suspended input tokens so that multiple async UIs can be loading and we correctly suspend
-	// for the duration of all of them.
+	// Input suspensions held while the widget stacks transition, one per transitioning stack
 	//
-	TArray<FName> SuspendInputTokens;
+	TArray<FUIInputSuspensionHandle> StackTransitionSuspensions;
 
 	//
 	// The registered layers for the primary layout.
@@ -68,80 +327,321 @@ private:
 	UPROPERTY(Transient, meta = (Categories = "UI.Layer"))
 	TMap<FGameplayTag, TObjectPtr<UCommonActivatableWidgetContainerBase>> Layers;
 
+	//
+	// The layer each widget pushed through this layout lives on, so that it can be removed without searching every layer.
+	// Entries are kept until the widget leaves the layer, even while it is deactivated below the displayed one.
+	//
+	TMap<TObjectKey<UCommonActivatableWidget>, FGameplayTag> WidgetLayerIndex;
+
+	//
+	// The widget last displayed by each layer, the only one the layer can pop by itself without going through this layout
+	//
+	TMap<FGameplayTag, TWeakObjectPtr<UCommonActivatableWidget>> DisplayedLayerWidgets;
+
+	//
+	// The panels caching the paint of layers registered with a retained render mode
+	//
+	struct FUILayerRenderCache
+	{
+		TWeakObjectPtr<URetainerBox> RetainerBox;
+		TWeakObjectPtr<UInvalidationBox> InvalidationBox;
+	};
+
+	TMap<FGameplayTag, FUILayerRenderCache> LayerRenderCaches;
+
+	//
+	// The registered layers from bottom to top, layers registered later are considered to be drawn above earlier ones
+	//
+	TArray<FGameplayTag> LayerOrder;
+
+	//
+	// Visibility of the layers collapsed because a fullscreen opaque widget is displayed above them
+	//
+	TMap<FGameplayTag, ESlateVisibility> CoveredLayerVisibilities;
+
 protected:
 	/** 
 	 * Register a layer that widgets can be pushed onto. 
 	 */
+	UFUNCTION(BlueprintCallable, Category = "Layer", meta = (GameplayTagFilter = "UI.Layer", AutoCreateRefTerm = "RenderSettings"))
+	void RegisterLayer(FGameplayTag LayerTag, UCommonActivatableWidgetContainerBase* LayerWidget, const FUILayerRenderSettings& RenderSettings);
+
+	/**
+	 * Register a layer that widgets can be pushed onto with the default render settings.
+	 */
+	void RegisterLayer(FGameplayTag LayerTag, UCommonActivatableWidgetContainerBase* LayerWidget) { RegisterLayer(LayerTag, LayerWidget, FUILayerRenderSettings()); }
+
+	/**
+	 * Finds the caching panel around the layer and configures it for the render mode
+	 */
+	void SetupLayerRenderCache(FGameplayTag LayerTag, UCommonActivatableWidgetContainerBase* LayerWidget, const FUILayerRenderSettings& RenderSettings);
+
+	void HandleLayerDisplayedWidgetChanged(UCommonActivatableWidget* DisplayedWidget, FGameplayTag LayerTag);
+
+	/**
+	 * Collapses the layers below the topmost fullscreen opaque widget, restores the others and
+	 * updates the covered state of every widget on the layers
+	 */
+	void UpdateLayerOcclusion();
+
+	void SetLayerCovered(FGameplayTag LayerTag, UCommonActivatableWidgetContainerBase* LayerWidget, bool bCovered);
+
+public:
+	/**
+	 * Requests the cached paint of the layer to be refreshed on the next frame.
+	 * Pushes and removals through this layout do this automatically.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Layer", meta = (GameplayTagFilter = "UI.Layer"))
-	void RegisterLayer(FGameplayTag LayerTag, UCommonActivatableWidgetContainerBase* LayerWidget);
+	void InvalidateLayerRendering(FGameplayTag LayerTag);
+
+protected:
 
 	void OnWidgetStackTransitioning(UCommonActivatableWidgetContainerBase* Widget, bool bIsTransitioning);
 
+	/**
+	 * Called after every push of a widget to a layer of this layout, whether it was loaded asynchronously or not
+	 */
+	virtual void NotifyWidgetPushedToLayer(UCommonActivatableWidget* ActivatableWidget, FGameplayTag LayerName);
+
+	void RegisterWidgetOnLayer(UCommonActivatableWidget* ActivatableWidget, FGameplayTag LayerName);
+
+	/**
+	 * Removes the index entry of the widget if it still points to the layer
+	 */
+	void RemoveWidgetFromLayerIndex(UCommonActivatableWidget* ActivatableWidget, FGameplayTag LayerName);
+
+private:
+	//
+	// Handles that keep the prefetched widget classes loaded for the lifetime of the layout
+	//
+	TArray<TSharedPtr<FStreamableHandle>> PrefetchHandles;
+
+	//
+	// Prefetched widget classes shared through the UI policy with the other local players
+	//
+	TArray<FSoftObjectPath> SharedPrefetchPaths;
+
+	//
+	// Every widget class requested by the prefetch, whether it is held locally or shared
+	//
+	TSet<FSoftObjectPath> PrefetchedPaths;
+
+	//
+	// Player the shared prefetch classes were acquired for
+	//
+	TWeakObjectPtr<const ULocalPlayer> SharedPrefetchPlayer;
+
+	//
+	// Whether the async pushes of this layout were served from loaded classes
+	//
+	FUILayerPrefetchStats PrefetchStats;
+
+protected:
+	//
+	// Widget classes to load as soon as this layout is created as a root layout
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Prefetch", meta = (TitleProperty = "{LayerTag} -> {WidgetClass}"))
+	TArray<FUILayerPrefetchEntry> PrefetchEntries;
+
+	/**
+	 * Collects the widget classes this layout wants to prefetch
+	 */
+	virtual void GatherPrefetchEntries(TArray<FUILayerPrefetchEntry>& OutEntries) const;
+
+public:
+	/**
+	 * Starts loading the prefetch entries of this layout together with the additional entries
+	 * 
+	 * Tips:
+	 *	If a UI policy is active, the classes are acquired from it so that local players share a single load.
+	 */
+	void StartPrefetch(const TArray<FUILayerPrefetchEntry>& AdditionalEntries);
+
+	/**
+	 * Releases the prefetched widget classes
+	 */
+	void ReleasePrefetch();
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Prefetch")
+	FUILayerPrefetchStats GetPrefetchStats() const { return PrefetchStats; }
+
+private:
+	//
+	// Instances kept alive by the warm cache, they are reused once they have left their layer
+	//
+	UPROPERTY(Transient)
+	TArray<FUIWarmWidgetInstance> WarmInstances;
+
+protected:
+	//
+	// Widget classes whose instances are kept after being popped and reused on the next push to the same layer
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Warm Cache", meta = (TitleProperty = "{LayerTag} -> {WidgetClass}"))
+	TArray<FUIWarmWidgetCacheRule> WarmCacheRules;
+
+	/**
+	 * Returns an instance from the warm cache ready to be pushed, or null if the class is not cached or the cap is reached.
+	 */
+	UCommonActivatableWidget* AcquireWarmInstance(FGameplayTag LayerName, UClass* ActivatableWidgetClass, UCommonActivatableWidgetContainerBase* Layer);
+
+	const FUIWarmWidgetCacheRule* FindWarmCacheRule(FGameplayTag LayerName, UClass* ActivatableWidgetClass) const;
+
+	/**
+	 * Creates the missing instances of the warm cache rule if its class is loaded
+	 */
+	void CreateWarmInstances(const FUIWarmWidgetCacheRule& Rule);
+
+private:
+	//
+	// Loads of the warm cache classes started by PreWarmLayerContent
+	//
+	TArray<TSharedPtr<FUIAsyncLoadRequest>> PreWarmLoadRequests;
+
+	void HandlePreWarmClassLoaded(int32 RuleIndex);
+
+public:
+	/**
+	 * Creates the instances of every warm cache rule ahead of their first push, streaming the classes that are not loaded yet.
+	 * 
+	 * Tips:
+	 *	Used to build the layer content while a loading screen is up, the instances are reused by the first pushes.
+	 */
+	void PreWarmLayerContent();
+
+	/**
+	 * Releases every instance kept by the warm cache
+	 */
+	void FlushWarmCache();
+
+private:
+	UPROPERTY(Transient)
+	TMap<FGameplayTag, FUIEvictedWidgetStack> EvictedEntries;
+
+	//
+	// Set while an evicted entry is pushed back, so that the restore does not evict entries again
+	//
+	bool bRestoringEvictedEntry{ false };
+
+protected:
+	//
+	// Maximum number of entries kept alive on each stack layer, older inactive entries are released and restored
+	// from their class and SaveGame properties when the user navigates back to them
+	//
+	UPROPERTY(EditDefaultsOnly, Category = "Eviction", meta = (Categories = "UI.Layer", ClampMin = 1))
+	TMap<FGameplayTag, int32> LayerLiveEntryBudgets;
+
+	/**
+	 * Releases the oldest entries of the stack layer that are beyond its budget
+	 */
+	void EvictLayerEntriesOverBudget(FGameplayTag LayerName);
+
+	/**
+	 * Pushes back the most recently evicted entry once the last live entry of the stack layer has left it
+	 *
+	 * Tips:
+	 *	Called from the displayed widget change of the layer after the pop has completed,
+	 *	so the stack is never modified while it is still deactivating the leaving widget.
+	 */
+	void RestoreEvictedLayerEntry(FGameplayTag LayerName);
+
+public:
+	/**
+	 * Forgets the entries evicted from the layer without restoring them
+	 */
+	void ClearEvictedEntries(FGameplayTag LayerName);
+
 public:
 	/**
 	 * Find the widget if it exists on any of the layers and remove it from the layer.
 	 */
 	void FindAndRemoveWidgetFromLayer(UCommonActivatableWidget* ActivatableWidget);
 
+	/**
+	 * Returns the tag of the layer the widget was pushed to, or an empty tag if it is not on a layer of this layout.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Layer")
+	FGameplayTag GetLayerForWidget(const UCommonActivatableWidget* ActivatableWidget) const;
+
+	/**
+	 * Returns the position of the layer from the bottom, or INDEX_NONE if it is not registered
+	 */
+	int32 GetLayerDrawOrder(FGameplayTag LayerName) const { return LayerOrder.IndexOfByKey(LayerName); }
+
 	/**
 	 * Get the layer widget for the given layer tag.
 	 */
 	UCommonActivatableWidgetContainerBase* GetLayerWidget(FGameplayTag LayerName);
 
 	template <typename ActivatableWidgetT = UCommonActivatableWidget>
-	TSharedPtr<FStreamableHandle> PushWidgetToLayerStackAsync(FGameplayTag LayerName, bool bSuspendInputUntilComplete, TSoftClassPtr<UCommonActivatableWidget> ActivatableWidgetClass)
+	TSharedPtr<FUIAsyncLoadRequest> PushWidgetToLayerStackAsync(FGameplayTag LayerName, bool bSuspendInputUntilComplete, TSoftClassPtr<UCommonActivatableWidget> ActivatableWidgetClass)
 	{
 		return PushWidgetToLayerStackAsync<ActivatableWidgetT>(LayerName, bSuspendInputUntilComplete, ActivatableWidgetClass, [](EAsyncWidgetLayerState, ActivatableWidgetT*) {});
 	}
 
+	/**
+	 * Loads the widget class asynchronously and pushes it to the layer once it is loaded.
+	 * 
+	 * Tips:
+	 *	When the class is already loaded the widget is pushed immediately and the returned request has already completed.
+	 *	Loads of the same class are shared with every other async UI entry point through FUIAsyncLoadRegistry.
+	 */
 	template <typename ActivatableWidgetT = UCommonActivatableWidget>
-	TSharedPtr<FStreamableHandle> PushWidgetToLayerStackAsync(FGameplayTag LayerName, bool bSuspendInputUntilComplete, TSoftClassPtr<UCommonActivatableWidget> ActivatableWidgetClass, TFunction<void(EAsyncWidgetLayerState, ActivatableWidgetT*)> StateFunc)
+	TSharedPtr<FUIAsyncLoadRequest> PushWidgetToLayerStackAsync(FGameplayTag LayerName, bool bSuspendInputUntilComplete, TSoftClassPtr<UCommonActivatableWidget> ActivatableWidgetClass, TFunction<void(EAsyncWidgetLayerState, ActivatableWidgetT*)> StateFunc)
 	{
 		static_assert(TIsDerivedFrom<ActivatableWidgetT, UCommonActivatableWidget>::IsDerived, "Only CommonActivatableWidgets can be used here");
 
-		static const auto NAME_PushingWidgetToLayer{ FName(TEXT("PushingWidgetToLayer")) };
-		const auto SuspendInputToken{ bSuspendInputUntilComplete ? UUIFunctionLibrary::SuspendInputForPlayer(GetOwningPlayer(), NAME_PushingWidgetToLayer) : NAME_None };
-
-		auto& StreamableManager{ UAssetManager::Get().GetStreamableManager() };
-		auto StreamingHandle
-		{
-			StreamableManager.RequestAsyncLoad(
-				ActivatableWidgetClass.ToSoftObjectPath(), FStreamableDelegate::CreateWeakLambda(
-					this, [this, LayerName, ActivatableWidgetClass, StateFunc, SuspendInputToken]()
-					{
-						UUIFunctionLibrary::ResumeInputForPlayer(GetOwningPlayer(), SuspendInputToken);
-
-						auto* Widget
-						{
-							PushWidgetToLayerStack<ActivatableWidgetT>(
-								LayerName, ActivatableWidgetClass.Get(), [StateFunc](ActivatableWidgetT& WidgetToInit)
-								{
-									StateFunc(EAsyncWidgetLayerState::Initialize, &WidgetToInit);
-								}
-							)
-						};
-
-						StateFunc(EAsyncWidgetLayerState::AfterPush, Widget);
-					}
-				)
-			)
-		};
-
-		// Setup a cancel delegate so that we can resume input if this handler is canceled.
-
-		StreamingHandle->BindCancelDelegate(
-			FStreamableDelegate::CreateWeakLambda(
-				this, [this, StateFunc, SuspendInputToken]()
-				{
-					UUIFunctionLibrary::ResumeInputForPlayer(GetOwningPlayer(), SuspendInputToken);
-					StateFunc(EAsyncWidgetLayerState::Canceled, nullptr);
-				}
-			)
+		return PushWidgetToLayerStackAsyncInternal(LayerName, bSuspendInputUntilComplete, ActivatableWidgetClass,
+			[StateFunc](EAsyncWidgetLayerState State, UCommonActivatableWidget* Widget)
+			{
+				StateFunc(State, Cast<ActivatableWidgetT>(Widget));
+			}
 		);
-
-		return StreamingHandle;
 	}
 
+private:
+	//
+	// Async pushes waiting for the same class on the same layer, used to collapse duplicate pushes
+	//
+	struct FUIPendingLayerPush
+	{
+		int32 NumWaiters{ 0 };
+
+		TWeakObjectPtr<UCommonActivatableWidget> PushedWidget;
+	};
+
+	TMap<TTuple<FGameplayTag, FSoftObjectPath>, FUIPendingLayerPush> PendingLayerPushes;
+
+	void ReleasePendingLayerPush(const TTuple<FGameplayTag, FSoftObjectPath>& Key);
+
+protected:
+	TSharedPtr<FUIAsyncLoadRequest> PushWidgetToLayerStackAsyncInternal(FGameplayTag LayerName, bool bSuspendInputUntilComplete, TSoftClassPtr<UCommonActivatableWidget> ActivatableWidgetClass, TFunction<void(EAsyncWidgetLayerState, UCommonActivatableWidget*)> StateFunc);
+
+public:
+	/**
+	 * Returns the load priority of async pushes to the layer.
+	 * 
+	 * Tips:
+	 *	Uses the entry of the layer in the developer settings, or the entry of its closest parent tag.
+	 */
+	virtual int32 GetLayerLoadPriority(FGameplayTag LayerName) const;
+
+	/**
+	 * Returns how long the async pushes to the layer waited before their load was started
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Layer")
+	FUIAsyncLoadQueueStats GetLayerQueueStats(FGameplayTag LayerName) const;
+
+public:
+	/**
+	 * Starts loading every widget class of the sequence at once and pushes them in the declared order.
+	 * 
+	 * Tips:
+	 *	An entry is pushed as soon as its class and the classes of all entries before it are loaded.
+	 *	A single input suspension is held until the whole sequence is pushed or canceled.
+	 */
+	TSharedPtr<FUILayerPushSequence> PushWidgetSequenceToLayers(const TArray<FUILayerPushSequenceEntry>& Entries, bool bSuspendInputUntilComplete, FUILayerPushSequence::FStateFunc StateFunc = nullptr);
+
+public:
 	template <typename ActivatableWidgetT = UCommonActivatableWidget>
 	ActivatableWidgetT* PushWidgetToLayerStack(FGameplayTag LayerName, UClass* ActivatableWidgetClass)
 	{
@@ -155,12 +655,43 @@ public:
 
 		if (auto* Layer{ GetLayerWidget(LayerName) })
 		{
-			return Layer->AddWidget<ActivatableWidgetT>(ActivatableWidgetClass, InitInstanceFunc);
+			ActivatableWidgetT* Widget{ nullptr };
+
+			if (auto* WarmWidget{ Cast<ActivatableWidgetT>(AcquireWarmInstance(LayerName, ActivatableWidgetClass, Layer)) })
+			{
+				InitInstanceFunc(*WarmWidget);
+				Layer->AddWidgetInstance(*WarmWidget);
+
+				Widget = WarmWidget;
+			}
+			else
+			{
+				Widget = Layer->AddWidget<ActivatableWidgetT>(ActivatableWidgetClass, InitInstanceFunc);
+			}
+
+			NotifyWidgetPushedToLayer(Widget, LayerName);
+
+			return Widget;
 		}
 
 		return nullptr;
 	}
 
+public:
+	/**
+	 * Moves this layout and every widget under it to the player controller without removing it from the viewport.
+	 * 
+	 * Tips:
+	 *	Widgets that hold on to the old controller are notified through IUIPlayerContextReceiver.
+	 */
+	void RebindPlayerController(APlayerController* PlayerController);
+
+protected:
+	/**
+	 * Applies the player context to the widget and everything created under it that is not part of its widget tree (layer content, dynamic entries)
+	 */
+	void RebindUserWidget(UUserWidget* UserWidget, const FLocalPlayerContext& PlayerContext, APlayerController* OldPlayerController, APlayerController* NewPlayerController, bool bApplyContext);
+
 public:
 	static UUILayout* GetUILayoutForPrimaryPlayer(const UObject* WorldContextObject);
 	static UUILayout* GetUILayout(APlayerController* PlayerController);
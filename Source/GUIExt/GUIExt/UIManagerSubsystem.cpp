@@ -4,21 +4,40 @@
 
 #include "UIPolicy.h"
 #include "UIDeveloperSettings.h"
+#include "GUIExtLogs.h"
 
 #include "System/GFCGameInstance.h"
 
 #include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
 #include "GameFramework/HUD.h"
 #include "GameFramework/PlayerController.h"
 #include "Components/SlateWrapperTypes.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UIManagerSubsystem)
 
 
+static TAutoConsoleVariable<bool> CVarHeadlessUI(
+	TEXT("GUIExt.Headless"),
+	false,
+	TEXT("If true, the UI keeps its logical state without creating widgets. Read when the game instance is initialized."),
+	ECVF_Default
+);
+
+
 void UUIManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
+	bHeadless = IsHeadlessRequested();
+
+	if (bHeadless)
+	{
+		UE_LOG(LogGameExt_UI, Log, TEXT("[%s] runs the UI headless, no widget will be created"), *GetNameSafe(this));
+	}
+
 	if (auto* GI{ Cast<UGFCGameInstance>(GetGameInstance()) })
 	{
 		GI->Register_OnLocalPlayerAdded(UGFCGameInstance::FLocalPlayerAddedDelegate::FDelegate::CreateUObject(this, &ThisClass::HandleAddLocalPlayer));
@@ -27,27 +46,55 @@ void UUIManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 	if (!CurrentPolicy)
 	{
-		const auto* DevSettings{ GetDefault<UUIDeveloperSettings>() };
-		const auto UIPolicySoftClass{ DevSettings->DefaultUIPolicyClass };
-
-		if (!UIPolicySoftClass.IsNull())
-		{
-			auto* PolicyClass{ UIPolicySoftClass.TryLoadClass<UUIPolicy>() };
+		CreateDefaultPolicy();
+	}
 
-			SwitchToPolicy(NewObject<UUIPolicy>(this, PolicyClass));
-		}
+	if (GetDefault<UUIDeveloperSettings>()->bEnablePredictivePreloading)
+	{
+		UsagePredictor.Initialize();
 	}
 
-	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::Tick), 0.0f);
+	FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &ThisClass::HandlePreLoadMap);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ThisClass::HandlePostLoadMap);
+	FWorldDelegates::OnSeamlessTravelStart.AddUObject(this, &ThisClass::HandleSeamlessTravelStart);
+
+	// Only poll when HUD classes that do not notify their changes must be supported
+
+	if (GetDefault<UUIDeveloperSettings>()->bPollShowHUD)
+	{
+		RequestRootLayoutVisibilitySync();
+	}
 }
 
 void UUIManagerSubsystem::Deinitialize()
 {
 	Super::Deinitialize();
 
+	if (PolicyClassLoadRequest.IsValid())
+	{
+		PolicyClassLoadRequest->Cancel();
+		PolicyClassLoadRequest.Reset();
+	}
+
+	PendingAddedPlayers.Reset();
+
 	SwitchToPolicy(nullptr);
 
+	if (GetDefault<UUIDeveloperSettings>()->bEnablePredictivePreloading)
+	{
+		UsagePredictor.Deinitialize();
+	}
+
+	LastUsedWidgetClasses.Reset();
+
+	FrameScheduler.Reset();
+
 	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	TickHandle.Reset();
+
+	FCoreUObjectDelegates::PreLoadMap.RemoveAll(this);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
+	FWorldDelegates::OnSeamlessTravelStart.RemoveAll(this);
 }
 
 bool UUIManagerSubsystem::ShouldCreateSubsystem(UObject* Outer) const
@@ -70,7 +117,24 @@ bool UUIManagerSubsystem::Tick(float DeltaTime)
 {
 	SyncRootLayoutVisibilityToShowHUD();
 
-	return true;
+	const auto bKeepTicking{ GetDefault<UUIDeveloperSettings>()->bPollShowHUD };
+
+	if (!bKeepTicking)
+	{
+		TickHandle.Reset();
+	}
+
+	return bKeepTicking;
+}
+
+void UUIManagerSubsystem::RequestRootLayoutVisibilitySync()
+{
+	// There is no root layout to show or hide when headless
+
+	if (!bHeadless && !TickHandle.IsValid())
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::Tick), 0.0f);
+	}
 }
 
 void UUIManagerSubsystem::SyncRootLayoutVisibilityToShowHUD()
@@ -91,7 +155,11 @@ void UUIManagerSubsystem::SyncRootLayoutVisibilityToShowHUD()
 				}
 			}
 
-			if (auto* RootLayout{ Policy->GetRootLayout(LocalPlayer) })
+			// Dormant layouts stay collapsed until they wake up
+
+			auto* RootLayout{ Policy->GetRootLayout(LocalPlayer) };
+
+			if (RootLayout && !RootLayout->IsDormant())
 			{
 				const auto DesiredVisibility{ bShouldShowUI ? ESlateVisibility::SelfHitTestInvisible : ESlateVisibility::Collapsed };
 				if (DesiredVisibility != RootLayout->GetVisibility())
@@ -104,11 +172,115 @@ void UUIManagerSubsystem::SyncRootLayoutVisibilityToShowHUD()
 }
 
 
+bool UUIManagerSubsystem::IsHeadlessRequested()
+{
+	return CVarHeadlessUI.GetValueOnGameThread() || FParse::Param(FCommandLine::Get(), TEXT("UIHeadless"));
+}
+
+
 void UUIManagerSubsystem::SwitchToPolicy(UUIPolicy* InPolicy)
 {
 	if (CurrentPolicy != InPolicy)
 	{
+		auto* OldPolicy{ CurrentPolicy.Get() };
+
 		CurrentPolicy = InPolicy;
+
+		// The old policy hands its layouts over once the new one is current, so released layouts release their shared classes on it
+
+		if (OldPolicy)
+		{
+			OldPolicy->TransitionToPolicy(InPolicy);
+		}
+
+		RequestRootLayoutVisibilitySync();
+	}
+}
+
+void UUIManagerSubsystem::CreateDefaultPolicy()
+{
+	const auto& UIPolicySoftClass{ GetDefault<UUIDeveloperSettings>()->DefaultUIPolicyClass };
+
+	if (UIPolicySoftClass.IsNull())
+	{
+		return;
+	}
+
+	if (auto* PolicyClass{ UIPolicySoftClass.ResolveClass() })
+	{
+		SwitchToPolicy(NewObject<UUIPolicy>(this, PolicyClass));
+		return;
+	}
+
+	// Stream the class instead of blocking the game thread, players added in the meantime are queued
+
+	UE_LOG(LogGameExt_UI, Log, TEXT("[%s] is streaming the UI policy class [%s]"), *GetNameSafe(this), *UIPolicySoftClass.ToString());
+
+	static const auto NAME_UIBootstrap{ FName(TEXT("UIBootstrap")) };
+
+	PolicyClassLoadRequest = FUIAsyncLoadRegistry::Get().RequestAsyncLoad(
+		UIPolicySoftClass,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::HandlePolicyClassLoaded),
+		FStreamableDelegate(),
+		FStreamableManager::AsyncLoadHighPriority,
+		NAME_UIBootstrap
+	);
+}
+
+void UUIManagerSubsystem::HandlePolicyClassLoaded()
+{
+	PolicyClassLoadRequest.Reset();
+
+	if (CurrentPolicy)
+	{
+		return;
+	}
+
+	auto* PolicyClass{ GetDefault<UUIDeveloperSettings>()->DefaultUIPolicyClass.ResolveClass() };
+
+	if (!ensure(PolicyClass && PolicyClass->IsChildOf<UUIPolicy>()))
+	{
+		return;
+	}
+
+	SwitchToPolicy(NewObject<UUIPolicy>(this, PolicyClass));
+
+	auto AddedPlayers{ MoveTemp(PendingAddedPlayers) };
+	PendingAddedPlayers.Reset();
+
+	for (const auto& WeakPlayer : AddedPlayers)
+	{
+		if (auto* LocalPlayer{ WeakPlayer.Get() })
+		{
+			NotifyPlayerAdded(LocalPlayer);
+		}
+	}
+}
+
+
+void UUIManagerSubsystem::HandlePreLoadMap(const FString& MapName)
+{
+	if (CurrentPolicy)
+	{
+		CurrentPolicy->NotifyPreLoadMap();
+	}
+}
+
+void UUIManagerSubsystem::HandleSeamlessTravelStart(UWorld* CurrentWorld, const FString& LevelName)
+{
+	if (CurrentPolicy && CurrentWorld && (CurrentWorld->GetGameInstance() == GetGameInstance()))
+	{
+		CurrentPolicy->NotifySeamlessTravelStart();
+	}
+}
+
+void UUIManagerSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+	if (CurrentPolicy && LoadedWorld && (LoadedWorld->GetGameInstance() == GetGameInstance()))
+	{
+		CurrentPolicy->NotifyPostLoadMap(LoadedWorld);
+
+		RequestRootLayoutVisibilitySync();
 	}
 }
 
@@ -118,6 +290,12 @@ void UUIManagerSubsystem::NotifyPlayerAdded(ULocalPlayer* LocalPlayer)
 	if (ensure(LocalPlayer) && CurrentPolicy)
 	{
 		CurrentPolicy->NotifyPlayerAdded(LocalPlayer);
+
+		RequestRootLayoutVisibilitySync();
+	}
+	else if (LocalPlayer && PolicyClassLoadRequest.IsValid())
+	{
+		PendingAddedPlayers.AddUnique(LocalPlayer);
 	}
 }
 
@@ -126,15 +304,56 @@ void UUIManagerSubsystem::NotifyPlayerRemoved(ULocalPlayer* LocalPlayer)
 	if (LocalPlayer && CurrentPolicy)
 	{
 		CurrentPolicy->NotifyPlayerRemoved(LocalPlayer);
+
+		RequestRootLayoutVisibilitySync();
 	}
 }
 
 void UUIManagerSubsystem::NotifyPlayerDestroyed(ULocalPlayer* LocalPlayer)
 {
+	PendingAddedPlayers.Remove(LocalPlayer);
+
 	if (LocalPlayer && CurrentPolicy)
 	{
 		CurrentPolicy->NotifyPlayerDestroyed(LocalPlayer);
+
+		RequestRootLayoutVisibilitySync();
+	}
+}
+
+
+void UUIManagerSubsystem::NotifyWidgetClassUsed(const ULocalPlayer* LocalPlayer, FGameplayTag LayerTag, UClass* WidgetClass)
+{
+	const auto* DevSettings{ GetDefault<UUIDeveloperSettings>() };
+
+	if (!DevSettings->bEnablePredictivePreloading || !LocalPlayer || !WidgetClass)
+	{
+		return;
 	}
+
+	auto& LastUsedClass{ LastUsedWidgetClasses.FindOrAdd(LocalPlayer) };
+
+	UsagePredictor.RecordUsage(LastUsedClass, LayerTag, WidgetClass);
+
+	LastUsedClass = FSoftObjectPath(WidgetClass);
+
+	UsagePredictor.PreloadPredictions(LastUsedClass, DevSettings->MaxPredictedWidgetClasses, static_cast<int64>(DevSettings->PredictivePreloadBudgetKB) * 1024);
+}
+
+void UUIManagerSubsystem::PreloadPredictedWidgetClasses(const ULocalPlayer* LocalPlayer)
+{
+	const auto* DevSettings{ GetDefault<UUIDeveloperSettings>() };
+
+	if (!DevSettings->bEnablePredictivePreloading || !LocalPlayer)
+	{
+		return;
+	}
+
+	// A new layout starts from the empty context
+
+	LastUsedWidgetClasses.Add(LocalPlayer, FSoftObjectPath());
+
+	UsagePredictor.PreloadPredictions(FSoftObjectPath(), DevSettings->MaxPredictedWidgetClasses, static_cast<int64>(DevSettings->PredictivePreloadBudgetKB) * 1024);
 }
 
 
@@ -146,4 +365,6 @@ void UUIManagerSubsystem::HandleAddLocalPlayer(ULocalPlayer* NewPlayer, FPlatfor
 void UUIManagerSubsystem::HanldeRemoveLocalPlayer(ULocalPlayer* ExistingPlayer)
 {
 	NotifyPlayerDestroyed(ExistingPlayer);
+
+	LastUsedWidgetClasses.Remove(ExistingPlayer);
 }
@@ -4,6 +4,13 @@
 
 #include "Subsystems/GameInstanceSubsystem.h"
 
+#include "Loading/UIUsagePredictor.h"
+#include "Loading/UIAsyncLoadRegistry.h"
+#include "Scheduling/UIFrameScheduler.h"
+
+#include "GameplayTagContainer.h"
+#include "UObject/ObjectKey.h"
+
 #include "UIManagerSubsystem.generated.h"
 
 class ULocalPlayer;
@@ -26,21 +33,86 @@ public:
 	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
 
 
+protected:
+	//
+	// Whether the UI runs without widgets, decided once when the subsystem is initialized
+	//
+	bool bHeadless{ false };
+
+public:
+	/**
+	 * Returns true if the UI keeps its logical state (layers, extensions, input suspension) without creating any widget
+	 * 
+	 * Tips:
+	 *	Enabled with -UIHeadless on the command line or GUIExt.Headless=1, e.g. for load-test bots running with -NullRHI.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "UI")
+	bool IsHeadless() const { return bHeadless; }
+
+	static bool IsHeadlessRequested();
+
+
 protected:
 	FTSTicker::FDelegateHandle TickHandle;
 
 protected:
+	/**
+	 * Syncs the root layouts, keeps ticking only when bPollShowHUD is enabled
+	 */
 	bool Tick(float DeltaTime);
+
 	void SyncRootLayoutVisibilityToShowHUD();
 
+public:
+	/**
+	 * Applies the visibility of every root layout on the next tick.
+	 * 
+	 * Tips:
+	 *	Called on player, controller, dormancy and policy changes, and by AUIHUD when its bShowHUD changes.
+	 *	Several requests in the same frame sync only once.
+	 */
+	void RequestRootLayoutVisibilitySync();
+
 
 protected:
 	UPROPERTY(Transient)
 	TObjectPtr<UUIPolicy> CurrentPolicy{ nullptr };
 
-protected:
+	//
+	// Load of the default policy class while it is streamed in
+	//
+	TSharedPtr<FUIAsyncLoadRequest> PolicyClassLoadRequest;
+
+	//
+	// Players added before the policy was created, they are notified to the policy once it exists
+	//
+	TArray<TWeakObjectPtr<ULocalPlayer>> PendingAddedPlayers;
+
+public:
+	/**
+	 * Makes the policy current and lets the previous policy hand its root layouts and caches over to it
+	 * 
+	 * Tips:
+	 *	Layouts of the same class are kept as they are, so switching e.g. the multiplayer interaction mode does not rebuild the UI.
+	 */
 	void SwitchToPolicy(UUIPolicy* InPolicy);
 
+protected:
+	/**
+	 * Creates the default policy, streaming its class first if it is not loaded yet
+	 */
+	void CreateDefaultPolicy();
+
+	void HandlePolicyClassLoaded();
+
+	/**
+	 * Lets the policy prepare the root layouts for a map load while the loading screen is up
+	 */
+	void HandlePreLoadMap(const FString& MapName);
+
+	void HandleSeamlessTravelStart(UWorld* CurrentWorld, const FString& LevelName);
+	void HandlePostLoadMap(UWorld* LoadedWorld);
+
 public:
 	UUIPolicy* GetCurrentUIPolicy() const { return CurrentPolicy; }
 
@@ -48,6 +120,42 @@ public:
 	virtual void NotifyPlayerRemoved(ULocalPlayer* LocalPlayer);
 	virtual void NotifyPlayerDestroyed(ULocalPlayer* LocalPlayer);
 
+
+protected:
+	FUIUsagePredictor UsagePredictor;
+
+	//
+	// The widget class each player used last, used as the context of the next usage
+	//
+	TMap<TObjectKey<ULocalPlayer>, FSoftObjectPath> LastUsedWidgetClasses;
+
+public:
+	/**
+	 * Records that the widget class was pushed or created for the player and preloads the classes likely to be used next
+	 */
+	void NotifyWidgetClassUsed(const ULocalPlayer* LocalPlayer, FGameplayTag LayerTag, UClass* WidgetClass);
+
+	/**
+	 * Preloads the widget classes likely to be used first by the player, called when the root layout is created
+	 */
+	void PreloadPredictedWidgetClasses(const ULocalPlayer* LocalPlayer);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Prediction")
+	FUIUsagePredictionStats GetUsagePredictionStats() const { return UsagePredictor.GetStats(); }
+
+protected:
+	FUIFrameScheduler FrameScheduler;
+
+public:
+	/**
+	 * Returns the scheduler that runs deferred UI tasks within the per-frame budget
+	 */
+	FUIFrameScheduler& GetFrameScheduler() { return FrameScheduler; }
+	const FUIFrameScheduler& GetFrameScheduler() const { return FrameScheduler; }
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Scheduling")
+	FUIFrameSchedulerStats GetFrameSchedulerStats() const { return FrameScheduler.GetStats(); }
+
 private:
 	void HandleAddLocalPlayer(ULocalPlayer* NewPlayer, FPlatformUserId UserId);
 	void HanldeRemoveLocalPlayer(ULocalPlayer* ExistingPlayer);
@@ -4,13 +4,17 @@
 
 #include "UIManagerSubsystem.h"
 #include "UILayout.h"
+#include "GameplayTag/GUIETags_UI.h"
 #include "GUIExtLogs.h"
 
 #include "Player/GFCLocalPlayer.h"
 
 #include "Framework/Application/SlateApplication.h"
+#include "Engine/AssetManager.h"
 #include "Engine/GameInstance.h"
 #include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(UIPolicy)
 
@@ -18,6 +22,8 @@
 UUIPolicy::UUIPolicy(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
+	PersistentLayers.AddTag(TAG_UI_Layer_Menu);
+	PersistentLayers.AddTag(TAG_UI_Layer_Modal);
 }
 
 
@@ -28,7 +34,16 @@ void UUIPolicy::AddLayoutToViewport(ULocalPlayer* LocalPlayer, UUILayout* Layout
 	Layout->SetPlayerContext(FLocalPlayerContext(LocalPlayer));
 	Layout->AddToPlayerScreen(1000);
 
+	// Adding the layout resets its viewport slot
+
+	if (Layout->PersistsAcrossWorldChange())
+	{
+		Layout->ApplyPersistenceToViewportSlot();
+	}
+
 	OnRootLayoutAddedToViewport(LocalPlayer, Layout);
+
+	GetOwningUIManager()->RequestRootLayoutVisibilitySync();
 }
 
 void UUIPolicy::RemoveLayoutFromViewport(ULocalPlayer* LocalPlayer, UUILayout* Layout)
@@ -51,6 +66,30 @@ void UUIPolicy::RemoveLayoutFromViewport(ULocalPlayer* LocalPlayer, UUILayout* L
 }
 
 
+void UUIPolicy::RebindLayoutToPlayerController(ULocalPlayer* LocalPlayer, UUILayout* Layout, APlayerController* PlayerController)
+{
+	Layout->RebindPlayerController(PlayerController);
+
+	// Only layouts that are not on screen yet (e.g. created before the controller existed) are added
+
+	auto* LayoutInfo{ RootViewportLayouts.FindByKey(LocalPlayer) };
+
+	if (!Layout->IsInViewport() || (LayoutInfo && !LayoutInfo->bAddedToViewport))
+	{
+		AddLayoutToViewport(LocalPlayer, Layout);
+
+		if (LayoutInfo)
+		{
+			LayoutInfo->bAddedToViewport = true;
+		}
+	}
+
+	OnRootLayoutRebound(LocalPlayer, Layout, PlayerController);
+
+	GetOwningUIManager()->RequestRootLayoutVisibilitySync();
+}
+
+
 void UUIPolicy::OnRootLayoutAddedToViewport(ULocalPlayer* LocalPlayer, UUILayout* Layout)
 {
 #if WITH_EDITOR
@@ -71,51 +110,223 @@ void UUIPolicy::OnRootLayoutReleased(ULocalPlayer* LocalPlayer, UUILayout* Layou
 {
 }
 
+void UUIPolicy::OnRootLayoutRebound(ULocalPlayer* LocalPlayer, UUILayout* Layout, APlayerController* PlayerController)
+{
+}
+
+void UUIPolicy::OnRootLayoutDormancyChanged(ULocalPlayer* LocalPlayer, UUILayout* Layout, bool bIsDormant)
+{
+}
+
+void UUIPolicy::HandleRootLayoutDormancyChanged(bool bIsDormant, TWeakObjectPtr<UUILayout> WeakLayout)
+{
+	if (auto* Layout{ WeakLayout.Get() })
+	{
+		OnRootLayoutDormancyChanged(Layout->GetOwningLocalPlayer(), Layout, bIsDormant);
+
+		// A layout waking up has to catch up with bShowHUD changes made while it was dormant
+
+		if (!bIsDormant)
+		{
+			GetOwningUIManager()->RequestRootLayoutVisibilitySync();
+		}
+	}
+}
+
 
 void UUIPolicy::CreateLayoutWidget(ULocalPlayer* LocalPlayer)
 {
-	if (auto* PlayerController{ LocalPlayer->GetPlayerController(GetWorld()) })
+	// The layout is created by the pending load once the class arrives
+
+	if (PendingLayoutLoads.Contains(LocalPlayer))
 	{
-		auto LayoutWidgetClass{ GetLayoutWidgetClass(LocalPlayer) };
+		return;
+	}
 
-		if (ensure(LayoutWidgetClass && !LayoutWidgetClass->HasAnyClassFlags(CLASS_Abstract)))
+	// Headless players only get the logical layout, nothing is loaded or instantiated
+
+	if (GetOwningUIManager()->IsHeadless())
+	{
+		if (!HeadlessLayouts.Contains(LocalPlayer))
 		{
-			auto* NewLayoutObject{ CreateWidget<UUILayout>(PlayerController, LayoutWidgetClass) };
+			UE_LOG(LogGameExt_UI, Log, TEXT("[%s] created player [%s]'s headless root layout"), *GetName(), *GetNameSafe(LocalPlayer));
+
+			HeadlessLayouts.Add(LocalPlayer);
+		}
+
+		return;
+	}
 
-			RootViewportLayouts.Emplace(LocalPlayer, NewLayoutObject, true);
+	auto* PlayerController{ LocalPlayer->GetPlayerController(GetWorld()) };
 
+	if (!PlayerController && !bPreCreateLayoutsWithoutController)
+	{
+		return;
+	}
+
+	auto LayoutWidgetClass{ GetLayoutWidgetClass(LocalPlayer) };
+
+	if (!LayoutWidgetClass && !LayoutClass.IsNull())
+	{
+		if (!FailedLayoutLoads.Contains(LocalPlayer))
+		{
+			RequestLayoutWidgetClass(LocalPlayer);
+		}
+
+		return;
+	}
+
+	if (ensure(LayoutWidgetClass && !LayoutWidgetClass->HasAnyClassFlags(CLASS_Abstract)))
+	{
+		RemovePlaceholderLayout(LocalPlayer);
+
+		// The layout is always owned by the game instance, so rebinding it to a new controller does not keep the old one (and its world) reachable.
+		// The controller is only referenced through the player context.
+
+		auto* NewLayoutObject{ CreateWidget<UUILayout>(LocalPlayer->GetGameInstance(), LayoutWidgetClass) };
+		NewLayoutObject->SetPlayerContext(FLocalPlayerContext(LocalPlayer));
+
+		RootViewportLayouts.Emplace(LocalPlayer, NewLayoutObject, PlayerController != nullptr);
+
+		NewLayoutObject->OnLayoutDormancyChanged().AddUObject(this, &ThisClass::HandleRootLayoutDormancyChanged, TWeakObjectPtr<UUILayout>(NewLayoutObject));
+
+		if (PlayerController)
+		{
 			AddLayoutToViewport(LocalPlayer, NewLayoutObject);
 		}
+		else
+		{
+			UE_LOG(LogGameExt_UI, Log, TEXT("[%s] pre-created player [%s]'s root layout [%s] without a controller"), *GetName(), *GetNameSafe(LocalPlayer), *GetNameSafe(NewLayoutObject));
+		}
+
+		TArray<FUILayerPrefetchEntry> Entries;
+		GatherPrefetchEntries(LocalPlayer, Entries);
+
+		NewLayoutObject->StartPrefetch(Entries);
+
+		if (bPreWarmLayoutContent)
+		{
+			NewLayoutObject->PreWarmLayerContent();
+		}
+
+		GetOwningUIManager()->PreloadPredictedWidgetClasses(LocalPlayer);
 	}
 }
 
+void UUIPolicy::PreCreateLayoutWidgets()
+{
+	if (!bPreCreateLayoutsWithoutController || GetOwningUIManager()->IsHeadless())
+	{
+		return;
+	}
 
-void UUIPolicy::NotifyPlayerAdded(ULocalPlayer* LocalPlayer)
+	for (auto* LocalPlayer : GetOwningUIManager()->GetGameInstance()->GetLocalPlayers())
+	{
+		if (LocalPlayer && !RootViewportLayouts.FindByKey(LocalPlayer))
+		{
+			CreateLayoutWidget(LocalPlayer);
+		}
+	}
+}
+
+void UUIPolicy::RequestLayoutWidgetClass(ULocalPlayer* LocalPlayer)
 {
-	if (auto* GFCLP{ Cast<UGFCLocalPlayer>(LocalPlayer) })
+	UE_LOG(LogGameExt_UI, Log, TEXT("[%s] is streaming the layout class [%s] for player [%s]"), *GetName(), *LayoutClass.ToString(), *GetNameSafe(LocalPlayer));
+
+	AddPlaceholderLayout(LocalPlayer);
+
+	static const auto NAME_UIBootstrap{ FName(TEXT("UIBootstrap")) };
+
+	auto LoadRequest
 	{
-		GFCLP->OnPlayerControllerSet.AddWeakLambda(
-			this, [this](UGFCLocalPlayer* LocalPlayer, APlayerController* PlayerController)
-			{
-				NotifyPlayerRemoved(LocalPlayer);
+		FUIAsyncLoadRegistry::Get().RequestAsyncLoad(
+			LayoutClass.ToSoftObjectPath(),
+			FStreamableDelegate::CreateUObject(this, &ThisClass::HandleLayoutWidgetClassLoaded, TWeakObjectPtr<ULocalPlayer>(LocalPlayer)),
+			FStreamableDelegate(),
+			FStreamableManager::AsyncLoadHighPriority,
+			NAME_UIBootstrap
+		)
+	};
+
+	// The map may have changed during the request if the class was already loaded and the completion ran synchronously
+
+	if (LoadRequest.IsValid() && !LoadRequest->HasCompleted())
+	{
+		PendingLayoutLoads.Add(LocalPlayer, MoveTemp(LoadRequest));
+	}
+}
 
-				if (auto* LayoutInfo{ RootViewportLayouts.FindByKey(LocalPlayer) })
-				{
-					AddLayoutToViewport(LocalPlayer, LayoutInfo->RootLayout);
-					LayoutInfo->bAddedToViewport = true;
-				}
-				else
-				{
-					CreateLayoutWidget(LocalPlayer);
-				}
-			}
-		);
+void UUIPolicy::HandleLayoutWidgetClassLoaded(TWeakObjectPtr<ULocalPlayer> WeakLocalPlayer)
+{
+	PendingLayoutLoads.Remove(WeakLocalPlayer.Get());
+
+	auto* LocalPlayer{ WeakLocalPlayer.Get() };
+
+	if (!LocalPlayer || RootViewportLayouts.FindByKey(LocalPlayer))
+	{
+		return;
+	}
+
+	// Requesting the class again would fail the same way on every frame
+
+	if (!LayoutClass.Get())
+	{
+		UE_LOG(LogGameExt_UI, Error, TEXT("[%s] failed to load the layout class [%s] for player [%s]"), *GetName(), *LayoutClass.ToString(), *GetNameSafe(LocalPlayer));
+
+		FailedLayoutLoads.Add(LocalPlayer);
+		return;
+	}
+
+	CreateLayoutWidget(LocalPlayer);
+}
+
+void UUIPolicy::AddPlaceholderLayout(ULocalPlayer* LocalPlayer)
+{
+	if (!PlaceholderLayoutClass || PlaceholderLayouts.Contains(LocalPlayer))
+	{
+		return;
+	}
+
+	if (auto* PlayerController{ LocalPlayer->GetPlayerController(GetWorld()) })
+	{
+		if (auto* Placeholder{ CreateWidget<UUserWidget>(PlayerController, PlaceholderLayoutClass) })
+		{
+			Placeholder->AddToPlayerScreen(1000);
+
+			PlaceholderLayouts.Add(LocalPlayer, Placeholder);
+		}
+	}
+}
+
+void UUIPolicy::RemovePlaceholderLayout(ULocalPlayer* LocalPlayer)
+{
+	TObjectPtr<UUserWidget> Placeholder;
+
+	if (PlaceholderLayouts.RemoveAndCopyValue(LocalPlayer, Placeholder) && Placeholder)
+	{
+		Placeholder->RemoveFromParent();
 	}
+}
+
+void UUIPolicy::GatherPrefetchEntries(ULocalPlayer* LocalPlayer, TArray<FUILayerPrefetchEntry>& OutEntries) const
+{
+	OutEntries.Append(PrefetchEntries);
+}
+
+
+void UUIPolicy::NotifyPlayerAdded(ULocalPlayer* LocalPlayer)
+{
+	ListenPlayerControllerSet(LocalPlayer);
 
 	if (auto* LayoutInfo{ RootViewportLayouts.FindByKey(LocalPlayer) })
 	{
-		AddLayoutToViewport(LocalPlayer, LayoutInfo->RootLayout);
-		LayoutInfo->bAddedToViewport = true;
+		// A layout pre-created without a controller waits for the controller to be set
+
+		if (LocalPlayer->GetPlayerController(GetWorld()))
+		{
+			AddLayoutToViewport(LocalPlayer, LayoutInfo->RootLayout);
+			LayoutInfo->bAddedToViewport = true;
+		}
 	}
 	else
 	{
@@ -163,6 +374,286 @@ void UUIPolicy::NotifyPlayerDestroyed(ULocalPlayer* LocalPlayer)
 		GFCLP->OnPlayerControllerSet.RemoveAll(this);
 	}
 
+	TSharedPtr<FUIAsyncLoadRequest> PendingLoad;
+
+	if (PendingLayoutLoads.RemoveAndCopyValue(LocalPlayer, PendingLoad) && PendingLoad.IsValid())
+	{
+		PendingLoad->Cancel();
+	}
+
+	FailedLayoutLoads.Remove(LocalPlayer);
+
+	RemovePlaceholderLayout(LocalPlayer);
+
+	ReleaseRootLayout(LocalPlayer);
+
+	HeadlessLayouts.Remove(LocalPlayer);
+
+	ReleaseSharedWidgetClasses(LocalPlayer);
+}
+
+
+void UUIPolicy::NotifyPreLoadMap()
+{
+	for (const auto& LayoutInfo : RootViewportLayouts)
+	{
+		if (auto* Layout{ LayoutInfo.RootLayout.Get() })
+		{
+			Layout->SetPersistAcrossWorldChange(false);
+		}
+	}
+
+	for (auto& KVP : HeadlessLayouts)
+	{
+		KVP.Value.SetPersistAcrossWorldChange(false);
+	}
+
+	PreCreateLayoutWidgets();
+}
+
+void UUIPolicy::NotifySeamlessTravelStart()
+{
+	if (!bPersistLayoutsAcrossSeamlessTravel)
+	{
+		return;
+	}
+
+	for (const auto& LayoutInfo : RootViewportLayouts)
+	{
+		if (auto* Layout{ LayoutInfo.RootLayout.Get() })
+		{
+			UE_LOG(LogGameExt_UI, Log, TEXT("[%s] keeps player [%s]'s root layout [%s] across seamless travel"), *GetName(), *GetNameSafe(LayoutInfo.LocalPlayer), *GetNameSafe(Layout));
+
+			Layout->SetPersistAcrossWorldChange(true);
+			Layout->CullLayersForTravel(PersistentLayers);
+		}
+	}
+
+	for (auto& KVP : HeadlessLayouts)
+	{
+		KVP.Value.SetPersistAcrossWorldChange(true);
+		KVP.Value.CullLayersForTravel(PersistentLayers);
+	}
+}
+
+void UUIPolicy::NotifyPostLoadMap(UWorld* LoadedWorld)
+{
+	for (const auto& LayoutInfo : RootViewportLayouts)
+	{
+		auto* Layout{ LayoutInfo.RootLayout.Get() };
+
+		if (!Layout || !Layout->PersistsAcrossWorldChange())
+		{
+			continue;
+		}
+
+		// Seamless travel may pass through a transition map first, the layout stays persistent until the destination is loaded
+
+		if (!GEngine->SeamlessTravelHandlerForWorld(LoadedWorld).IsInTransition())
+		{
+			Layout->SetPersistAcrossWorldChange(false);
+		}
+
+		if (auto* PlayerController{ LayoutInfo.LocalPlayer ? LayoutInfo.LocalPlayer->GetPlayerController(LoadedWorld) : nullptr })
+		{
+			RebindLayoutToPlayerController(LayoutInfo.LocalPlayer, Layout, PlayerController);
+		}
+	}
+
+	// Headless layouts lose their content with the world, as a root layout widget would
+
+	const auto bInTransition{ GEngine->SeamlessTravelHandlerForWorld(LoadedWorld).IsInTransition() };
+
+	for (auto& KVP : HeadlessLayouts)
+	{
+		if (!KVP.Value.PersistsAcrossWorldChange())
+		{
+			KVP.Value.ClearAll();
+		}
+		else if (!bInTransition)
+		{
+			KVP.Value.SetPersistAcrossWorldChange(false);
+		}
+	}
+}
+
+
+void UUIPolicy::TransitionToPolicy(UUIPolicy* NewPolicy)
+{
+	UE_LOG(LogGameExt_UI, Log, TEXT("[%s] is handing the UI over to [%s]"), *GetName(), *GetNameSafe(NewPolicy));
+
+	const auto& LocalPlayers{ GetOwningUIManager()->GetGameInstance()->GetLocalPlayers() };
+
+	for (auto* LocalPlayer : LocalPlayers)
+	{
+		if (auto* GFCLP{ Cast<UGFCLocalPlayer>(LocalPlayer) })
+		{
+			GFCLP->OnPlayerControllerSet.RemoveAll(this);
+		}
+	}
+
+	// Layouts still being streamed in are rebuilt by the new policy
+
+	for (const auto& KVP : PendingLayoutLoads)
+	{
+		if (KVP.Value.IsValid())
+		{
+			KVP.Value->Cancel();
+		}
+	}
+
+	PendingLayoutLoads.Reset();
+	FailedLayoutLoads.Reset();
+
+	TArray<TObjectPtr<ULocalPlayer>> PlaceholderPlayers;
+	PlaceholderLayouts.GetKeys(PlaceholderPlayers);
+
+	for (const auto& LocalPlayer : PlaceholderPlayers)
+	{
+		RemovePlaceholderLayout(LocalPlayer);
+	}
+
+	// Move the caches first, so that the layouts released below release their shared classes on the new policy
+
+	if (NewPolicy)
+	{
+		for (auto& KVP : SharedWidgetClasses)
+		{
+			if (auto* Existing{ NewPolicy->SharedWidgetClasses.Find(KVP.Key) })
+			{
+				for (const auto& User : KVP.Value.Users)
+				{
+					Existing->Users.FindOrAdd(User.Key) += User.Value;
+				}
+
+				if (KVP.Value.Handle.IsValid())
+				{
+					KVP.Value.Handle->ReleaseHandle();
+				}
+			}
+			else
+			{
+				NewPolicy->SharedWidgetClasses.Add(KVP.Key, MoveTemp(KVP.Value));
+			}
+		}
+
+		SharedWidgetClasses.Reset();
+
+		NewPolicy->HeadlessLayouts.Append(MoveTemp(HeadlessLayouts));
+		HeadlessLayouts.Reset();
+	}
+
+	const auto LayoutInfos{ RootViewportLayouts };
+
+	for (const auto& LayoutInfo : LayoutInfos)
+	{
+		auto* LocalPlayer{ LayoutInfo.LocalPlayer.Get() };
+		auto* Layout{ LayoutInfo.RootLayout.Get() };
+
+		if (NewPolicy && LocalPlayer && Layout && CanMigrateLayout(LocalPlayer, Layout, NewPolicy))
+		{
+			UE_LOG(LogGameExt_UI, Log, TEXT("[%s] hands player [%s]'s root layout [%s] over to [%s]"), *GetName(), *GetNameSafe(LocalPlayer), *GetNameSafe(Layout), *GetNameSafe(NewPolicy));
+
+			RootViewportLayouts.RemoveAll([Layout](const FRootViewportLayoutInfo& Other) { return Other.RootLayout == Layout; });
+			Layout->OnLayoutDormancyChanged().RemoveAll(this);
+
+			NewPolicy->RootViewportLayouts.Add(LayoutInfo);
+			Layout->OnLayoutDormancyChanged().AddUObject(NewPolicy, &ThisClass::HandleRootLayoutDormancyChanged, TWeakObjectPtr<UUILayout>(Layout));
+
+			NewPolicy->OnRootLayoutMigrated(LocalPlayer, Layout, this);
+		}
+		else
+		{
+			ReleaseRootLayout(LocalPlayer);
+		}
+	}
+
+	if (NewPolicy)
+	{
+		for (auto* LocalPlayer : LocalPlayers)
+		{
+			if (NewPolicy->RootViewportLayouts.FindByKey(LocalPlayer))
+			{
+				NewPolicy->ListenPlayerControllerSet(LocalPlayer);
+			}
+			else
+			{
+				NewPolicy->NotifyPlayerAdded(LocalPlayer);
+			}
+		}
+	}
+	else
+	{
+		for (const auto& KVP : SharedWidgetClasses)
+		{
+			if (KVP.Value.Handle.IsValid())
+			{
+				KVP.Value.Handle->ReleaseHandle();
+			}
+		}
+
+		SharedWidgetClasses.Reset();
+		HeadlessLayouts.Reset();
+	}
+}
+
+bool UUIPolicy::CanMigrateLayout(ULocalPlayer* LocalPlayer, UUILayout* Layout, UUIPolicy* NewPolicy)
+{
+	// The layout class of the new policy may not be loaded yet, the paths match if it is the same class
+
+	if (auto NewLayoutClass{ NewPolicy->GetLayoutWidgetClass(LocalPlayer) })
+	{
+		return NewLayoutClass == Layout->GetClass();
+	}
+
+	return NewPolicy->LayoutClass.ToSoftObjectPath() == FSoftObjectPath(Layout->GetClass());
+}
+
+void UUIPolicy::OnRootLayoutMigrated(ULocalPlayer* LocalPlayer, UUILayout* Layout, UUIPolicy* OldPolicy)
+{
+	// Only SingleToggle keeps layouts dormant
+
+	if ((MultiplayerInteractionMode != EUIMultiplayerInteractionMode::SingleToggle) && Layout->IsDormant())
+	{
+		Layout->SetIsDormant(false);
+	}
+}
+
+
+void UUIPolicy::ListenPlayerControllerSet(ULocalPlayer* LocalPlayer)
+{
+	if (auto* GFCLP{ Cast<UGFCLocalPlayer>(LocalPlayer) })
+	{
+		GFCLP->OnPlayerControllerSet.AddWeakLambda(
+			this, [this](UGFCLocalPlayer* LocalPlayer, APlayerController* PlayerController)
+			{
+				auto* LayoutInfo{ RootViewportLayouts.FindByKey(LocalPlayer) };
+
+				if (LayoutInfo && LayoutInfo->RootLayout && PlayerController)
+				{
+					RebindLayoutToPlayerController(LocalPlayer, LayoutInfo->RootLayout, PlayerController);
+				}
+				else
+				{
+					NotifyPlayerRemoved(LocalPlayer);
+
+					if (LayoutInfo)
+					{
+						AddLayoutToViewport(LocalPlayer, LayoutInfo->RootLayout);
+						LayoutInfo->bAddedToViewport = true;
+					}
+					else
+					{
+						CreateLayoutWidget(LocalPlayer);
+					}
+				}
+			}
+		);
+	}
+}
+
+void UUIPolicy::ReleaseRootLayout(ULocalPlayer* LocalPlayer)
+{
 	const auto LayoutInfoIdx{ RootViewportLayouts.IndexOfByKey(LocalPlayer) };
 	if (LayoutInfoIdx != INDEX_NONE)
 	{
@@ -172,6 +663,13 @@ void UUIPolicy::NotifyPlayerDestroyed(ULocalPlayer* LocalPlayer)
 
 		RemoveLayoutFromViewport(LocalPlayer, Layout);
 
+		if (Layout)
+		{
+			Layout->OnLayoutDormancyChanged().RemoveAll(this);
+			Layout->ReleasePrefetch();
+			Layout->FlushWarmCache();
+		}
+
 		OnRootLayoutReleased(LocalPlayer, Layout);
 	}
 }
@@ -196,9 +694,134 @@ void UUIPolicy::RequestPrimaryControl(UUILayout* Layout)
 }
 
 
+TSharedPtr<FStreamableHandle> UUIPolicy::AcquireSharedWidgetClass(const ULocalPlayer* LocalPlayer, const FSoftObjectPath& ClassPath, TAsyncLoadPriority Priority)
+{
+	// Nothing is instanced from the classes when headless, so they are not loaded either
+
+	if (!LocalPlayer || ClassPath.IsNull() || GetOwningUIManager()->IsHeadless())
+	{
+		return nullptr;
+	}
+
+	if (auto* SharedClass{ SharedWidgetClasses.Find(ClassPath) })
+	{
+		SharedClass->Users.FindOrAdd(LocalPlayer)++;
+
+		UE_LOG(LogGameExt_UI, Verbose, TEXT("[%s] shares [%s] with player [%s] (Players: %d)"), *GetName(), *ClassPath.ToString(), *GetNameSafe(LocalPlayer), SharedClass->Users.Num());
+
+		return SharedClass->Handle;
+	}
+
+	auto Handle{ UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(ClassPath, FStreamableDelegate(), Priority) };
+
+	if (Handle.IsValid())
+	{
+		auto& SharedClass{ SharedWidgetClasses.Add(ClassPath) };
+		SharedClass.Handle = Handle;
+		SharedClass.Users.Add(LocalPlayer, 1);
+	}
+
+	return Handle;
+}
+
+void UUIPolicy::ReleaseSharedWidgetClass(const ULocalPlayer* LocalPlayer, const FSoftObjectPath& ClassPath)
+{
+	auto* SharedClass{ SharedWidgetClasses.Find(ClassPath) };
+	auto* NumAcquisitions{ SharedClass ? SharedClass->Users.Find(LocalPlayer) : nullptr };
+
+	if (!NumAcquisitions)
+	{
+		return;
+	}
+
+	if (--(*NumAcquisitions) <= 0)
+	{
+		SharedClass->Users.Remove(LocalPlayer);
+	}
+
+	if (SharedClass->Users.IsEmpty())
+	{
+		if (SharedClass->Handle.IsValid())
+		{
+			SharedClass->Handle->ReleaseHandle();
+		}
+
+		SharedWidgetClasses.Remove(ClassPath);
+	}
+}
+
+void UUIPolicy::ReleaseSharedWidgetClasses(const ULocalPlayer* LocalPlayer)
+{
+	for (auto It{ SharedWidgetClasses.CreateIterator() }; It; ++It)
+	{
+		auto& SharedClass{ It.Value() };
+
+		if (SharedClass.Users.Remove(LocalPlayer) > 0 && SharedClass.Users.IsEmpty())
+		{
+			if (SharedClass.Handle.IsValid())
+			{
+				SharedClass.Handle->ReleaseHandle();
+			}
+
+			It.RemoveCurrent();
+		}
+	}
+}
+
+FUIPlayerWidgetMemoryReport UUIPolicy::GetPlayerWidgetMemoryReport(const ULocalPlayer* LocalPlayer) const
+{
+	FUIPlayerWidgetMemoryReport Report;
+
+	for (const auto& KVP : SharedWidgetClasses)
+	{
+		const auto NumUsers{ KVP.Value.Users.Num() };
+
+		if (!KVP.Value.Users.Contains(LocalPlayer))
+		{
+			continue;
+		}
+
+		const auto* Class{ Cast<UClass>(KVP.Key.ResolveObject()) };
+		const auto ClassBytes{ Class ? static_cast<int64>(Class->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal)) : 0 };
+
+		Report.NumClasses++;
+		Report.NumSharedClasses += (NumUsers > 1) ? 1 : 0;
+		Report.ClassBytes += ClassBytes / NumUsers;
+		Report.UnsharedClassBytes += ClassBytes;
+	}
+
+	for (TObjectIterator<UUserWidget> It; It; ++It)
+	{
+		if (!It->IsTemplate() && (It->GetOwningLocalPlayer() == LocalPlayer))
+		{
+			Report.NumWidgetInstances++;
+			Report.WidgetInstanceBytes += static_cast<int64>(It->GetResourceSizeBytes(EResourceSizeMode::Exclusive));
+		}
+	}
+
+	return Report;
+}
+
+void UUIPolicy::LogWidgetMemoryReports() const
+{
+	UE_LOG(LogGameExt_UI, Log, TEXT("[%s] shares %d widget classes"), *GetName(), SharedWidgetClasses.Num());
+
+	for (const auto* LocalPlayer : GetOwningUIManager()->GetGameInstance()->GetLocalPlayers())
+	{
+		const auto Report{ GetPlayerWidgetMemoryReport(LocalPlayer) };
+
+		UE_LOG(LogGameExt_UI, Log, TEXT("  Player [%d]: Classes %d (%d shared), Class memory %.1fKB (%.1fKB unshared), Instances %d, Instance memory %.1fKB"),
+			LocalPlayer ? LocalPlayer->GetControllerId() : -1,
+			Report.NumClasses, Report.NumSharedClasses,
+			Report.ClassBytes / 1024.0, Report.UnsharedClassBytes / 1024.0,
+			Report.NumWidgetInstances, Report.WidgetInstanceBytes / 1024.0);
+	}
+}
+
+
 TSubclassOf<UUILayout> UUIPolicy::GetLayoutWidgetClass(ULocalPlayer* LocalPlayer)
 {
-	return LayoutClass.LoadSynchronous();
+	return LayoutClass.Get();
 }
 
 UWorld* UUIPolicy::GetWorld() const
@@ -219,6 +842,24 @@ UUILayout* UUIPolicy::GetRootLayout(const ULocalPlayer* LocalPlayer) const
 }
 
 
+FUIHeadlessLayout* UUIPolicy::GetHeadlessLayout(const ULocalPlayer* LocalPlayer)
+{
+	return HeadlessLayouts.Find(LocalPlayer);
+}
+
+const FUIHeadlessLayout* UUIPolicy::GetHeadlessLayout(const ULocalPlayer* LocalPlayer) const
+{
+	return HeadlessLayouts.Find(LocalPlayer);
+}
+
+FUIHeadlessLayoutStats UUIPolicy::GetHeadlessLayoutStats(const ULocalPlayer* LocalPlayer) const
+{
+	const auto* HeadlessLayout{ GetHeadlessLayout(LocalPlayer) };
+
+	return HeadlessLayout ? HeadlessLayout->GetStats() : FUIHeadlessLayoutStats();
+}
+
+
 UUIPolicy* UUIPolicy::GetUIPolicy(const UObject* WorldContextObject)
 {
 	if (auto* World{ GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) })
@@ -234,3 +875,18 @@ UUIPolicy* UUIPolicy::GetUIPolicy(const UObject* WorldContextObject)
 
 	return nullptr;
 }
+
+
+static FAutoConsoleCommandWithWorld WidgetMemoryReportCommand(
+	TEXT("GUIExt.WidgetMemoryReport"),
+	TEXT("Writes the shared widget classes and the estimated UI memory of every local player to the log"),
+	FConsoleCommandWithWorldDelegate::CreateStatic(
+		[](UWorld* World)
+		{
+			if (const auto* Policy{ UUIPolicy::GetUIPolicy(World) })
+			{
+				Policy->LogWidgetMemoryReports();
+			}
+		}
+	)
+);
@@ -2,9 +2,13 @@
 
 #pragma once
 
+#include "UILayout.h"
+#include "Headless/UIHeadlessLayout.h"
+
 #include "UIPolicy.generated.h"
 
 class ULocalPlayer;
+class APlayerController;
 class UUIManagerSubsystem;
 class UUILayout;
 
@@ -55,6 +59,56 @@ public:
 };
 
 
+/**
+ * Estimated memory of the UI of a single player, shared classes are split between the players using them
+ */
+USTRUCT(BlueprintType)
+struct FUIPlayerWidgetMemoryReport
+{
+	GENERATED_BODY()
+public:
+	FUIPlayerWidgetMemoryReport() {}
+
+public:
+	//
+	// Number of shared widget classes used by the player
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 NumClasses{ 0 };
+
+	//
+	// Number of those classes also used by other players
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 NumSharedClasses{ 0 };
+
+	//
+	// Memory of the classes used by the player, divided by the number of players using each class
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int64 ClassBytes{ 0 };
+
+	//
+	// Memory the player would need for the same classes without sharing
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int64 UnsharedClassBytes{ 0 };
+
+	//
+	// Number of widget instances owned by the player
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int32 NumWidgetInstances{ 0 };
+
+	//
+	// Memory of the widget instances owned by the player
+	//
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	int64 WidgetInstanceBytes{ 0 };
+
+};
+
+
 /**
  * Display information for the root portion of the UI layout
  */
@@ -75,28 +129,209 @@ protected:
 	UPROPERTY(EditAnywhere)
 	TSoftClassPtr<UUILayout> LayoutClass{ nullptr };
 
+	//
+	// Lightweight widget shown to the player while the layout class is streamed in
+	//
+	UPROPERTY(EditAnywhere)
+	TSubclassOf<UUserWidget> PlaceholderLayoutClass{ nullptr };
+
+	//
+	// If true, root layouts are created as soon as a player exists, even before it has a controller (e.g. while a loading screen is up).
+	// They are added to the viewport once the controller is set.
+	//
+	UPROPERTY(EditAnywhere, Category = "Loading")
+	bool bPreCreateLayoutsWithoutController{ false };
+
+	//
+	// If true, the warm cache content of the root layouts is instantiated as soon as they are created
+	//
+	UPROPERTY(EditAnywhere, Category = "Loading")
+	bool bPreWarmLayoutContent{ false };
+
+	//
+	// If true, root layouts stay in the viewport during seamless travel instead of being rebuilt in the new world
+	//
+	UPROPERTY(EditAnywhere, Category = "Travel")
+	bool bPersistLayoutsAcrossSeamlessTravel{ false };
+
+	//
+	// Layers whose content is kept across seamless travel, the other layers are cleared when the travel starts
+	//
+	UPROPERTY(EditAnywhere, Category = "Travel", meta = (Categories = "UI.Layer", EditCondition = "bPersistLayoutsAcrossSeamlessTravel"))
+	FGameplayTagContainer PersistentLayers;
+
+	//
+	// Widget classes to load as soon as a root layout is created, in addition to the ones declared by the layout
+	//
+	UPROPERTY(EditAnywhere, meta = (TitleProperty = "{LayerTag} -> {WidgetClass}"))
+	TArray<FUILayerPrefetchEntry> PrefetchEntries;
+
 	UPROPERTY(Transient)
 	TArray<FRootViewportLayoutInfo> RootViewportLayouts;
 
+	//
+	// Placeholders displayed to the players whose layout class is still being streamed in
+	//
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<ULocalPlayer>, TObjectPtr<UUserWidget>> PlaceholderLayouts;
+
+	//
+	// Loads of the layout class started for each player
+	//
+	TMap<TObjectKey<ULocalPlayer>, TSharedPtr<FUIAsyncLoadRequest>> PendingLayoutLoads;
+
+	//
+	// Players whose layout class failed to load, they are not retried until the player or the policy is replaced
+	//
+	TSet<TObjectKey<ULocalPlayer>> FailedLayoutLoads;
+
+	//
+	// Logical root layouts of the players used instead of RootViewportLayouts when the UI runs headless
+	//
+	TMap<TObjectKey<ULocalPlayer>, FUIHeadlessLayout> HeadlessLayouts;
+
 protected:
 	void AddLayoutToViewport(ULocalPlayer* LocalPlayer, UUILayout* Layout);
 	void RemoveLayoutFromViewport(ULocalPlayer* LocalPlayer, UUILayout* Layout);
 
+	/**
+	 * Moves the root layout to the new controller of the player in place, it is only added to the viewport if it is not already on it
+	 */
+	void RebindLayoutToPlayerController(ULocalPlayer* LocalPlayer, UUILayout* Layout, APlayerController* PlayerController);
+
 	virtual void OnRootLayoutAddedToViewport(ULocalPlayer* LocalPlayer, UUILayout* Layout);
 	virtual void OnRootLayoutRemovedFromViewport(ULocalPlayer* LocalPlayer, UUILayout* Layout);
 	virtual void OnRootLayoutReleased(ULocalPlayer* LocalPlayer, UUILayout* Layout);
+	virtual void OnRootLayoutRebound(ULocalPlayer* LocalPlayer, UUILayout* Layout, APlayerController* PlayerController);
+
+	/**
+	 * Notifies that the root layout of the player has become dormant or woken up
+	 */
+	virtual void OnRootLayoutDormancyChanged(ULocalPlayer* LocalPlayer, UUILayout* Layout, bool bIsDormant);
+
+	void HandleRootLayoutDormancyChanged(bool bIsDormant, TWeakObjectPtr<UUILayout> WeakLayout);
 
 	void CreateLayoutWidget(ULocalPlayer* LocalPlayer);
 
+	/**
+	 * Creates the root layouts of the players that do not have one yet, called before a map is loaded
+	 */
+	void PreCreateLayoutWidgets();
+
+	/**
+	 * Streams the layout class for the player and creates the layout once it is loaded
+	 */
+	void RequestLayoutWidgetClass(ULocalPlayer* LocalPlayer);
+
+	void HandleLayoutWidgetClassLoaded(TWeakObjectPtr<ULocalPlayer> WeakLocalPlayer);
+
+	void AddPlaceholderLayout(ULocalPlayer* LocalPlayer);
+	void RemovePlaceholderLayout(ULocalPlayer* LocalPlayer);
+
+	/**
+	 * Collects the widget classes to prefetch for the root layout of the player
+	 */
+	virtual void GatherPrefetchEntries(ULocalPlayer* LocalPlayer, TArray<FUILayerPrefetchEntry>& OutEntries) const;
+
 	void NotifyPlayerAdded(ULocalPlayer* LocalPlayer);
 	void NotifyPlayerRemoved(ULocalPlayer* LocalPlayer);
 	void NotifyPlayerDestroyed(ULocalPlayer* LocalPlayer);
 
+	/**
+	 * Drops the persistence of the root layouts before a non-seamless map load and pre-creates the missing layouts
+	 */
+	virtual void NotifyPreLoadMap();
+
+	/**
+	 * Marks the root layouts to survive the world change and culls the layers that are not persistent
+	 */
+	virtual void NotifySeamlessTravelStart();
+
+	/**
+	 * Rebinds the root layouts kept across the travel to the controllers of the new world
+	 */
+	virtual void NotifyPostLoadMap(UWorld* LoadedWorld);
+
+	/**
+	 * Hands the root layouts, the caches and the player bindings of this policy over to the new policy.
+	 * 
+	 * Tips:
+	 *	Called by the UI manager once the new policy is current, a null policy releases everything.
+	 *	Layouts that the new policy would also create are moved as they are, the others are released and rebuilt by the new policy.
+	 */
+	virtual void TransitionToPolicy(UUIPolicy* NewPolicy);
+
+	/**
+	 * Returns true if the root layout can be kept as it is by the new policy
+	 */
+	virtual bool CanMigrateLayout(ULocalPlayer* LocalPlayer, UUILayout* Layout, UUIPolicy* NewPolicy);
+
+	/**
+	 * Notifies that the root layout of the player was taken over from the old policy
+	 */
+	virtual void OnRootLayoutMigrated(ULocalPlayer* LocalPlayer, UUILayout* Layout, UUIPolicy* OldPolicy);
+
+	void ListenPlayerControllerSet(ULocalPlayer* LocalPlayer);
+
+	/**
+	 * Removes the root layout of the player from the viewport and releases its caches
+	 */
+	void ReleaseRootLayout(ULocalPlayer* LocalPlayer);
+
 public:
 	void RequestPrimaryControl(UUILayout* Layout);
 
 
+private:
+	//
+	// Widget class loaded once for every local player that uses it
+	//
+	struct FUISharedWidgetClass
+	{
+		TSharedPtr<FStreamableHandle> Handle;
+
+		//
+		// Number of acquisitions of each player
+		//
+		TMap<TObjectKey<ULocalPlayer>, int32> Users;
+	};
+
+	TMap<FSoftObjectPath, FUISharedWidgetClass> SharedWidgetClasses;
+
+public:
+	/**
+	 * Keeps the widget class loaded for the player, sharing a single load with every other player using it.
+	 * 
+	 * Tips:
+	 *	The class is loaded once and every player after the first only pays for instancing.
+	 *	Each call must be balanced by ReleaseSharedWidgetClass, or by ReleaseSharedWidgetClasses when the player leaves.
+	 */
+	TSharedPtr<FStreamableHandle> AcquireSharedWidgetClass(const ULocalPlayer* LocalPlayer, const FSoftObjectPath& ClassPath, TAsyncLoadPriority Priority = FStreamableManager::DefaultAsyncLoadPriority);
+
+	void ReleaseSharedWidgetClass(const ULocalPlayer* LocalPlayer, const FSoftObjectPath& ClassPath);
+
+	/**
+	 * Releases every widget class acquired for the player
+	 */
+	void ReleaseSharedWidgetClasses(const ULocalPlayer* LocalPlayer);
+
+	int32 GetNumSharedWidgetClasses() const { return SharedWidgetClasses.Num(); }
+
+	/**
+	 * Estimates the UI memory of the player, splitting the memory of shared classes between their users
+	 */
+	FUIPlayerWidgetMemoryReport GetPlayerWidgetMemoryReport(const ULocalPlayer* LocalPlayer) const;
+
+	/**
+	 * Writes the memory report of every local player to the log
+	 */
+	void LogWidgetMemoryReports() const;
+
+
 protected:
+	/**
+	 * Returns the layout class for the player, or nullptr if it has not been loaded yet
+	 */
 	TSubclassOf<UUILayout> GetLayoutWidgetClass(ULocalPlayer* LocalPlayer);
 
 public:
@@ -104,6 +339,15 @@ public:
 	UUIManagerSubsystem* GetOwningUIManager() const;
 	UUILayout* GetRootLayout(const ULocalPlayer* LocalPlayer) const;
 
+	/**
+	 * Returns the logical root layout of the player, only exists when the UI runs headless
+	 */
+	FUIHeadlessLayout* GetHeadlessLayout(const ULocalPlayer* LocalPlayer);
+	const FUIHeadlessLayout* GetHeadlessLayout(const ULocalPlayer* LocalPlayer) const;
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Headless")
+	FUIHeadlessLayoutStats GetHeadlessLayoutStats(const ULocalPlayer* LocalPlayer) const;
+
 	EUIMultiplayerInteractionMode GetLocalMultiplayerInteractionMode() const { return MultiplayerInteractionMode; }
 
 public: